@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+Networked movement benchmark: for every replication path and player count, starts a dedicated server with
+-NetBenchmark and N headless clients driven by the benchmark scenarios, waits for the server report and
+summarizes every run in a Markdown table.
+
+python Scripts/run_net_benchmark.py --editor "C:/UE_5.3/Engine/Binaries/Win64/UnrealEditor.exe"
+    [--players 16 64 128] [--paths legacy iris] [--warmup 10] [--duration 60] [--scenario All]
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROJECT_FILE = os.path.join(PROJECT_DIR, "MovementExhibition.uproject")
+BENCHMARK_DIR = os.path.join(PROJECT_DIR, "Saved", "Benchmarks")
+
+
+def iris_flag(path):
+    return "-UseIrisReplication=1" if path == "iris" else "-UseIrisReplication=0"
+
+
+def run(args, path, players):
+    output = os.path.join(BENCHMARK_DIR, "NetBenchmark_%s_%d.json" % (path, players))
+    if os.path.exists(output):
+        os.remove(output)
+
+    server = subprocess.Popen([
+        args.editor, PROJECT_FILE, args.map, "-server", "-nullrhi", "-unattended", "-log",
+        iris_flag(path), "-NetBenchmark",
+        "-BenchmarkClients=%d" % players,
+        "-BenchmarkWarmup=%d" % args.warmup,
+        "-BenchmarkDuration=%d" % args.duration,
+        "-BenchmarkOutput=%s" % output,
+        "-csvCategories=ExhibitionMovement,Replication", "-csvExecCmds=csvprofile start",
+    ])
+
+    # Give the server time to open its port before the clients knock
+    time.sleep(args.server_delay)
+
+    clients = []
+    for _ in range(players):
+        clients.append(subprocess.Popen([
+            args.editor, PROJECT_FILE, "127.0.0.1", "-game", "-nullrhi", "-nosound", "-unattended",
+            iris_flag(path), "-BenchmarkScenario=%s" % args.scenario, "-ExecCmds=t.MaxFPS %d" % args.client_fps,
+        ], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL))
+        time.sleep(args.client_delay)
+
+    try:
+        server.wait(timeout=args.timeout)
+    except subprocess.TimeoutExpired:
+        print("Server did not finish %s with %d players in time" % (path, players), file=sys.stderr)
+        server.kill()
+    finally:
+        for client in clients:
+            client.kill()
+
+    if not os.path.exists(output):
+        return None
+
+    with open(output) as report:
+        return json.load(report)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--editor", required=True, help="UnrealEditor executable")
+    parser.add_argument("--map", default="L_Playground")
+    parser.add_argument("--players", type=int, nargs="+", default=[16, 64, 128])
+    parser.add_argument("--paths", nargs="+", choices=["legacy", "iris"], default=["legacy", "iris"])
+    parser.add_argument("--scenario", default="All")
+    parser.add_argument("--warmup", type=int, default=10)
+    parser.add_argument("--duration", type=int, default=60)
+    parser.add_argument("--client-fps", type=int, default=30)
+    parser.add_argument("--server-delay", type=float, default=20.0)
+    parser.add_argument("--client-delay", type=float, default=0.5)
+    parser.add_argument("--timeout", type=float, default=1800.0)
+    args = parser.parse_args()
+
+    os.makedirs(BENCHMARK_DIR, exist_ok=True)
+
+    rows = []
+    for players in args.players:
+        for path in args.paths:
+            print("Running %s replication with %d players" % (path, players))
+            report = run(args, path, players)
+            if report is None:
+                rows.append("| %s | %d | - | - | - | - | - |" % (path, players))
+                continue
+
+            game_thread = report["ServerGameThread"]
+            bandwidth = report["ServerBandwidth"]
+            rows.append("| %s | %d | %d | %.2f | %.2f | %.1f | %.1f |" % (
+                report["Replication"], players, report["Clients"],
+                game_thread["MeanMs"], game_thread["P99Ms"],
+                bandwidth["OutBytesPerSecond"] / 1024.0, bandwidth["OutBytesPerSecondPerClient"] / 1024.0,
+            ))
+
+    summary = "\n".join([
+        "| Replication | Players | Connected | Server game thread mean (ms) | p99 (ms) | Out (KiB/s) | Out per client (KiB/s) |",
+        "|---|---|---|---|---|---|---|",
+    ] + rows)
+
+    summary_file = os.path.join(BENCHMARK_DIR, "NetBenchmark_%s.md" % time.strftime("%Y.%m.%d-%H.%M.%S"))
+    with open(summary_file, "w") as summary_output:
+        summary_output.write(summary + "\n")
+
+    print(summary)
+    print("Saved %s" % summary_file)
+
+
+if __name__ == "__main__":
+    main()
@@ -10,7 +10,10 @@ public class MovementExhibition : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "CableComponent" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "CableComponent", "Json", "NetCore" });
+
+		// Iris is compiled in, net.Iris.UseIrisReplication decides which replication path runs
+		SetupIrisSupport(Target);
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
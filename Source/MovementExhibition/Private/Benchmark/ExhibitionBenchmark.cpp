@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/ExhibitionBenchmark.h"
+
+#include "Characters/ExhibitionCharacter.h"
+#include "Components/ExhibitionMovementComponent.h"
+
+namespace ExhibitionBenchmark
+{
+	static void Apply(AExhibitionCharacter& Character, UExhibitionMovementComponent& Movement, const EAction Action)
+	{
+		switch (Action)
+		{
+		case EAction::ToggleSprint:
+			Movement.ToggleSprint();
+			break;
+		case EAction::ToggleCrouch:
+			Character.ToggleCrouch();
+			break;
+		case EAction::Jump:
+			Character.Jump();
+			break;
+		case EAction::StopJumping:
+			Character.StopJumping();
+			break;
+		case EAction::Dive:
+			Movement.RequestDive();
+			break;
+		case EAction::RequestHook:
+			Movement.RequestHook();
+			break;
+		case EAction::ReleaseHook:
+			Movement.ReleaseHook();
+			break;
+		case EAction::Turn:
+			Character.AddActorWorldRotation(FRotator(0.f, 90.f, 0.f));
+			break;
+		}
+	}
+
+	TArray<FScenario> MakeScenarios()
+	{
+		return {
+			{ TEXT("SprintSlide"), 3.f, {
+				{ 0.f, EAction::ToggleSprint },
+				{ 1.f, EAction::ToggleCrouch },
+				{ 2.f, EAction::ToggleCrouch },
+				{ 2.5f, EAction::ToggleSprint },
+				{ 2.9f, EAction::Turn },
+			}},
+			{ TEXT("HookChain"), 2.f, {
+				{ 0.f, EAction::RequestHook },
+				{ 1.5f, EAction::ReleaseHook },
+				{ 1.6f, EAction::Turn },
+			}},
+			{ TEXT("RopeJump"), 3.f, {
+				{ 0.f, EAction::Jump },
+				{ 0.2f, EAction::StopJumping },
+				{ 2.5f, EAction::Turn },
+			}},
+			{ TEXT("DiveDodge"), 2.f, {
+				{ 0.f, EAction::ToggleSprint },
+				{ 0.6f, EAction::Dive },
+				{ 1.2f, EAction::ToggleSprint },
+				{ 1.5f, EAction::Dive },
+				{ 1.9f, EAction::Turn },
+			}},
+		};
+	}
+
+	FScenarioPlayer::FScenarioPlayer(const FScenario& InScenario)
+		: Scenario(InScenario)
+	{
+	}
+
+	void FScenarioPlayer::Tick(AExhibitionCharacter& Character, UExhibitionMovementComponent& Movement, const float DeltaTime)
+	{
+		while (NextEvent < Scenario.Events.Num() && Scenario.Events[NextEvent].Time <= ScenarioTime)
+		{
+			Apply(Character, Movement, Scenario.Events[NextEvent].Action);
+			++NextEvent;
+		}
+
+		ScenarioTime += DeltaTime;
+		if (ScenarioTime >= Scenario.Period)
+		{
+			ScenarioTime -= Scenario.Period;
+			NextEvent = 0;
+		}
+
+		Character.AddMovementInput(Character.GetActorForwardVector());
+	}
+
+	double Percentile(const TArray<double>& SortedSamples, const double Ratio)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Ratio * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+}
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Camera/ExhibitionCameraEffectStack.h"
+
+#include "Camera/CameraTypes.h"
+#include "Data/ExhibitionBakedCurve.h"
+
+bool FExhibitionCameraEffectStack::Push(const FName Id, const FExhibitionCameraEffect& Effect)
+{
+	if (FEntry* Entry = FindEntry(Id))
+	{
+		Entry->Effect = Effect;
+		Entry->bReleased = false;
+		return true;
+	}
+
+	if (Entries.Num() >= Capacity)
+	{
+		return false;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Id = Id;
+	Entry.Effect = Effect;
+	return true;
+}
+
+void FExhibitionCameraEffectStack::Release(const FName Id)
+{
+	if (FEntry* Entry = FindEntry(Id))
+	{
+		Entry->bReleased = true;
+	}
+}
+
+bool FExhibitionCameraEffectStack::IsActive(const FName Id) const
+{
+	const FEntry* Entry = FindEntry(Id);
+	return Entry != nullptr && !Entry->bReleased;
+}
+
+void FExhibitionCameraEffectStack::SetMaterial(const FName Id, UMaterialInterface* Material)
+{
+	if (FEntry* Entry = FindEntry(Id))
+	{
+		Entry->Effect.Material = Material;
+	}
+}
+
+void FExhibitionCameraEffectStack::Update(const float DeltaTime)
+{
+	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	{
+		FEntry& Entry = Entries[i];
+		const float PreviousAlpha = Entry.Alpha;
+		if (Entry.bReleased)
+		{
+			Entry.Alpha = (Entry.Effect.BlendOutTime > 0.f)? Entry.Alpha - DeltaTime / Entry.Effect.BlendOutTime : 0.f;
+		}
+		else
+		{
+			Entry.Alpha = (Entry.Effect.BlendInTime > 0.f)? Entry.Alpha + DeltaTime / Entry.Effect.BlendInTime : 1.f;
+		}
+
+		Entry.Alpha = FMath::Clamp(Entry.Alpha, 0.f, 1.f);
+		if (Entry.bReleased && Entry.Alpha <= 0.f)
+		{
+			Entries.RemoveAt(i, 1, false);
+			continue;
+		}
+
+		// Settled blends keep their weight
+		if (Entry.Alpha != PreviousAlpha || Entry.Weight <= 0.f)
+		{
+			Entry.Weight = (Entry.Effect.BlendCurve != nullptr)? Entry.Effect.BlendCurve->Eval(Entry.Alpha) : Entry.Alpha;
+		}
+	}
+}
+
+void FExhibitionCameraEffectStack::Apply(FMinimalViewInfo& POV)
+{
+	if (Entries.IsEmpty())
+	{
+		return;
+	}
+
+	float FOVOffset = 0.f;
+	float BlurAmount = 0.f;
+	float BlurMax = 0.f;
+	bool bHasBlur = false;
+
+	// Inline slots, filling them never allocates
+	BlendableSlots.Reset();
+
+	for (const FEntry& Entry : Entries)
+	{
+		const FExhibitionCameraEffect& Effect = Entry.Effect;
+		FOVOffset += Effect.FOVOffset * Entry.Weight;
+		BlurAmount += Effect.BlurAmount * Entry.Weight;
+		BlurMax += Effect.BlurMax * Entry.Weight;
+		bHasBlur |= (Effect.BlurAmount != 0.f || Effect.BlurMax != 0.f);
+
+		if (Effect.Material != nullptr && Entry.Weight > 0.f)
+		{
+			BlendableSlots.Emplace(Entry.Weight, Effect.Material);
+		}
+	}
+
+	// The view is rebuilt every frame, it only gets an allocation when a material is actually blended
+	if (!BlendableSlots.IsEmpty())
+	{
+		POV.PostProcessSettings.WeightedBlendables.Array.Append(BlendableSlots);
+	}
+
+	POV.FOV += FOVOffset;
+
+	if (bHasBlur)
+	{
+		POV.PostProcessSettings.bOverride_MotionBlurAmount = true;
+		POV.PostProcessSettings.bOverride_MotionBlurMax = true;
+		POV.PostProcessSettings.MotionBlurAmount += BlurAmount;
+		POV.PostProcessSettings.MotionBlurMax += BlurMax;
+	}
+}
+
+void FExhibitionCameraEffectStack::Reset()
+{
+	Entries.Reset();
+}
+
+FExhibitionCameraEffectStack::FEntry* FExhibitionCameraEffectStack::FindEntry(const FName Id)
+{
+	return Entries.FindByPredicate([Id](const FEntry& Entry) { return Entry.Id == Id; });
+}
+
+const FExhibitionCameraEffectStack::FEntry* FExhibitionCameraEffectStack::FindEntry(const FName Id) const
+{
+	return Entries.FindByPredicate([Id](const FEntry& Entry) { return Entry.Id == Id; });
+}
@@ -5,50 +5,109 @@
 
 #include "Characters/ExhibitionCharacter.h"
 #include "Components/ExhibitionMovementComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Materials/MaterialInstance.h"
+#include "Stats/ExhibitionMovementStats.h"
 
-void AExhibitionCameraManager::Setup()
+DEFINE_LOG_CATEGORY_STATIC(LogExhibitionCamera, Log, All);
+
+namespace ExhibitionCameraEffects
+{
+	static const FName Crouch = TEXT("Crouch");
+	static const FName Hook = TEXT("Hook");
+	static const FName Rope = TEXT("Rope");
+}
+
+void AExhibitionCameraManager::Setup(AExhibitionCharacter* Character)
 {
-	if (CharacterRef != nullptr && MovementComponentRef != nullptr)
+	UExhibitionMovementComponent* MovementComponent = (Character != nullptr)? Character->GetExhibitionMovComponent() : nullptr;
+	if (Character == CharacterRef && MovementComponent == MovementComponentRef)
 	{
 		return;
 	}
-	
-	const APlayerController* PC = GetOwningPlayerController();
-	if (PC == nullptr)
+
+	UnbindMovementEvents();
+	CharacterRef = Character;
+	MovementComponentRef = MovementComponent;
+	BindMovementEvents();
+
+	SyncMovementState();
+}
+
+void AExhibitionCameraManager::BindMovementEvents()
+{
+	if (CharacterRef != nullptr)
+	{
+		CharacterRef->MovementModeChangedDelegate.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleMovementModeChanged);
+	}
+
+	if (MovementComponentRef == nullptr)
 	{
 		return;
 	}
 
-	CharacterRef = Cast<AExhibitionCharacter>(PC->GetCharacter());
-	if (CharacterRef == nullptr)
+	MovementComponentRef->OnStartSprint.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleLocomotionChanged);
+	MovementComponentRef->OnStopSprint.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleLocomotionChanged);
+	MovementComponentRef->OnStartWalk.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleLocomotionChanged);
+	MovementComponentRef->OnStopWalk.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleLocomotionChanged);
+	MovementComponentRef->OnStartCrouch.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleStartCrouch);
+	MovementComponentRef->OnEndCrouch.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleEndCrouch);
+	MovementComponentRef->OnEnterHook.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleEnterHook);
+	MovementComponentRef->OnExitHook.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleExitHook);
+	MovementComponentRef->OnEnterRope.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleEnterRope);
+	MovementComponentRef->OnExitRope.AddUniqueDynamic(this, &AExhibitionCameraManager::HandleExitRope);
+}
+
+void AExhibitionCameraManager::UnbindMovementEvents()
+{
+	if (CharacterRef != nullptr)
+	{
+		CharacterRef->MovementModeChangedDelegate.RemoveAll(this);
+	}
+
+	if (MovementComponentRef == nullptr)
 	{
 		return;
 	}
 
-	MovementComponentRef = CharacterRef->GetExhibitionMovComponent();
+	MovementComponentRef->OnStartSprint.RemoveAll(this);
+	MovementComponentRef->OnStopSprint.RemoveAll(this);
+	MovementComponentRef->OnStartWalk.RemoveAll(this);
+	MovementComponentRef->OnStopWalk.RemoveAll(this);
+	MovementComponentRef->OnStartCrouch.RemoveAll(this);
+	MovementComponentRef->OnEndCrouch.RemoveAll(this);
+	MovementComponentRef->OnEnterHook.RemoveAll(this);
+	MovementComponentRef->OnExitHook.RemoveAll(this);
+	MovementComponentRef->OnEnterRope.RemoveAll(this);
+	MovementComponentRef->OnExitRope.RemoveAll(this);
 }
 
-void AExhibitionCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+void AExhibitionCameraManager::SyncMovementState()
 {
-	Super::UpdateViewTarget(OutVT, DeltaTime);
+	EffectStack.Reset();
 
-	Setup();
-	ComputeCrouch(OutVT, DeltaTime);
+	bCrouching = MovementComponentRef != nullptr && MovementComponentRef->IsCrouching();
+	bHooking = MovementComponentRef != nullptr && MovementComponentRef->IsHooking();
 
-	if (MovementComponentRef != nullptr)
+	if (bCrouching)
 	{
-		if (MovementComponentRef->IsHooking())
-		{
-			ComputeHook(OutVT, DeltaTime);
-		}
-		if (MovementComponentRef->IsOnRope())
-		{
-			ComputeRope(OutVT, DeltaTime);
-		}
+		HandleStartCrouch();
+	}
+	if (MovementComponentRef != nullptr && MovementComponentRef->IsOnRope())
+	{
+		HandleEnterRope();
 	}
 
-	ComputeFOV(OutVT, DeltaTime);
-	HandleCameraShake(DeltaTime);
+	UpdateCameraShake();
+}
+
+void AExhibitionCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+{
+	Super::UpdateViewTarget(OutVT, DeltaTime);
+
+	ComputeCrouch(OutVT, DeltaTime);
+	ComputeEffects(OutVT, DeltaTime);
 }
 
 void AExhibitionCameraManager::ComputeCrouch(FTViewTarget& OutVT, float DeltaTime)
@@ -58,18 +117,18 @@ void AExhibitionCameraManager::ComputeCrouch(FTViewTarget& OutVT, float DeltaTim
 		return;
 	}
 
-	float TimeOffset = DeltaTime;
-	if (!MovementComponentRef->IsCrouching())
+	const float TimeOffset = bCrouching? DeltaTime : -DeltaTime;
+	const float LocationTime = FMath::Clamp(CrouchLocationTime + TimeOffset, 0.f, CrouchLocationDuration);
+	if (LocationTime != CrouchLocationTime)
 	{
-		TimeOffset = -DeltaTime;
+		CrouchLocationTime = LocationTime;
+		CrouchLocationRatio = BakedCrouchLocationCurve.Eval(CrouchLocationTime / CrouchLocationDuration);
 	}
 
-	CrouchLocationTime = FMath::Clamp(CrouchLocationTime + TimeOffset, 0.f, CrouchLocationDuration);
-	const float LocationRatio = CrouchLocationCurve.GetRichCurveConst()->Eval(CrouchLocationTime / CrouchLocationDuration);
 	const FVector TargetLocationOffset = {0.f, 0.f, MovementComponentRef->GetCrouchedHalfHeight() - MovementComponentRef->GetInitialCapsuleHalfHeight()};
-	FVector LocationOffset = FMath::Lerp(FVector::ZeroVector, TargetLocationOffset, LocationRatio);
+	FVector LocationOffset = FMath::Lerp(FVector::ZeroVector, TargetLocationOffset, CrouchLocationRatio);
 	
-	if (MovementComponentRef->IsCrouching())
+	if (bCrouching)
 	{
 		LocationOffset -= TargetLocationOffset;
 	}
@@ -77,151 +136,248 @@ void AExhibitionCameraManager::ComputeCrouch(FTViewTarget& OutVT, float DeltaTim
 	OutVT.POV.Location += LocationOffset;
 }
 
-void AExhibitionCameraManager::ComputeHook(FTViewTarget& OutVT, float DeltaTime)
+void AExhibitionCameraManager::ComputeEffects(FTViewTarget& OutVT, float DeltaTime)
 {
-	if (MovementComponentRef == nullptr)
+	// Only the hook effect depends on more than the movement mode
+	if (bHooking && MovementComponentRef != nullptr)
 	{
-		return;
+		const bool bFastHook = MovementComponentRef->Velocity.SizeSquared() >= FMath::Square(HookBlurSpeedThreshold);
+		SetEffectActive(ExhibitionCameraEffects::Hook, bFastHook, MakeHookEffect());
 	}
-	
-	const float CurrentSpeedSqr = MovementComponentRef->Velocity.SizeSquared();
-	if (MovementComponentRef->IsHooking() && CurrentSpeedSqr >= FMath::Square(HookBlurSpeedThreshold))
-	{
-		ToggleCustomBlur(OutVT, HookBlurAmountOffset, HookBlurMaxDistortionOffset, true);
-		TogglePostProcessMaterial(OutVT, HookSpeedLines.LoadSynchronous(), true);
-	}
-	else if (OutVT.POV.PostProcessSettings.bOverride_MotionBlurAmount)
-	{
-		ToggleCustomBlur(OutVT, HookBlurAmountOffset, HookBlurMaxDistortionOffset, false);
-		TogglePostProcessMaterial(OutVT, HookSpeedLines.LoadSynchronous(), false);
-	}
-}
 
-void AExhibitionCameraManager::ComputeRope(FTViewTarget& OutVT, float DeltaTime)
-{
-	if (MovementComponentRef == nullptr)
+	if (EffectStack.IsEmpty())
 	{
 		return;
 	}
-	
-	if (MovementComponentRef->IsOnRope())
+
+	// Report every frame a material is needed but still streaming
+	if (EffectStack.IsActive(ExhibitionCameraEffects::Hook))
 	{
-		ToggleCustomBlur(OutVT, RopeBlurAmountOffset, RopeBlurMaxDistortionOffset, true);
-		TogglePostProcessMaterial(OutVT, RopeSpeedLines.LoadSynchronous(), true);
+		GetResidentMaterial(HookSpeedLines, HookSpeedLinesMaterial);
 	}
-	else if (OutVT.POV.PostProcessSettings.bOverride_MotionBlurAmount)
+	if (EffectStack.IsActive(ExhibitionCameraEffects::Rope))
 	{
-		ToggleCustomBlur(OutVT, RopeBlurAmountOffset, RopeBlurMaxDistortionOffset, false);
-		TogglePostProcessMaterial(OutVT, RopeSpeedLines.LoadSynchronous(), false);
+		GetResidentMaterial(RopeSpeedLines, RopeSpeedLinesMaterial);
 	}
+
+	EffectStack.Update(DeltaTime);
+	EffectStack.Apply(OutVT.POV);
 }
 
-void AExhibitionCameraManager::ComputeFOV(FTViewTarget& OutVT, float DeltaTime)
+void AExhibitionCameraManager::SetEffectActive(const FName Id, const bool bActive, const FExhibitionCameraEffect& Effect)
 {
-	if (MovementComponentRef == nullptr)
+	if (bActive == EffectStack.IsActive(Id))
 	{
 		return;
 	}
 
-	const float CrouchTimeOffset = (MovementComponentRef->IsCrouching())? DeltaTime : -DeltaTime;
-	const float RopeTimeOffset = (MovementComponentRef->IsOnRope())? DeltaTime : -DeltaTime;
-
-	// How I imagine ChatGPT under the hood
-	// (Here I'd probably change to a queue of "FOV Change Request")
-	float FOVOffset;
-	if (MovementComponentRef->IsCrouching())
-	{
-		FOVOffset = CalculateFov(CrouchTimeOffset, CrouchFOVDuration, -CrouchOffsetFOV, CrouchFOVCurve);
-	}
-	else if (MovementComponentRef->IsOnRope())
+	if (bActive)
 	{
-		FOVOffset = CalculateFov(RopeTimeOffset, RopeFOVDuration, RopeOffsetFOV, RopeFOVCurve);
+		EffectStack.Push(Id, Effect);
 	}
 	else
 	{
-		FOVOffset = CalculateFov(CrouchTimeOffset, CrouchFOVDuration, -CrouchOffsetFOV, CrouchFOVCurve);
+		EffectStack.Release(Id);
 	}
+}
 
-	OutVT.POV.FOV += FOVOffset;
+FExhibitionCameraEffect AExhibitionCameraManager::MakeCrouchEffect() const
+{
+	FExhibitionCameraEffect Effect;
+	Effect.FOVOffset = -CrouchOffsetFOV;
+	Effect.BlendInTime = CrouchFOVDuration;
+	Effect.BlendOutTime = CrouchFOVDuration;
+	Effect.BlendCurve = &BakedCrouchFOVCurve;
+	return Effect;
 }
 
-void AExhibitionCameraManager::HandleCameraShake(float DeltaTime)
+FExhibitionCameraEffect AExhibitionCameraManager::MakeHookEffect() const
 {
-	Setup();
+	FExhibitionCameraEffect Effect;
+	Effect.BlurAmount = HookBlurAmountOffset;
+	Effect.BlurMax = HookBlurMaxDistortionOffset;
+	Effect.Material = HookSpeedLinesMaterial;
+	return Effect;
+}
 
-	if (MovementComponentRef == nullptr)
+FExhibitionCameraEffect AExhibitionCameraManager::MakeRopeEffect() const
+{
+	FExhibitionCameraEffect Effect;
+	Effect.FOVOffset = RopeOffsetFOV;
+	Effect.BlurAmount = RopeBlurAmountOffset;
+	Effect.BlurMax = RopeBlurMaxDistortionOffset;
+	Effect.Material = RopeSpeedLinesMaterial;
+	Effect.BlendInTime = RopeFOVDuration;
+	Effect.BlendOutTime = RopeFOVDuration;
+	Effect.BlendCurve = &BakedRopeFOVCurve;
+	return Effect;
+}
+
+void AExhibitionCameraManager::UpdateCameraShake()
+{
+	EShakeState NewState = EShakeState::None;
+	if (MovementComponentRef != nullptr && MovementComponentRef->IsWalking())
 	{
-		return;
+		if (MovementComponentRef->IsSprinting())
+		{
+			NewState = EShakeState::Sprint;
+		}
+		else if (!MovementComponentRef->Velocity.IsZero())
+		{
+			NewState = EShakeState::Walk;
+		}
+		else
+		{
+			NewState = EShakeState::Idle;
+		}
 	}
 
-	if (!MovementComponentRef->IsWalking())
+	if (NewState == ShakeState)
 	{
-		StopAllCameraShakes();
+		return;
 	}
 
-	const float SpeedSqr = MovementComponentRef->Velocity.SizeSquared();
-	if (MovementComponentRef->IsSprinting())
+	ShakeState = NewState;
+	if (ActiveCameraShake != nullptr)
 	{
-		StartCameraShake(SprintCameraShake);
+		StopCameraShake(ActiveCameraShake);
+		ActiveCameraShake = nullptr;
 	}
-	else if (SpeedSqr > 0)
+
+	TSubclassOf<UCameraShakeBase> ShakeClass;
+	switch (ShakeState)
 	{
-		StartCameraShake(WalkCameraShake);
+	case EShakeState::Idle:
+		ShakeClass = IdleCameraShake;
+		break;
+	case EShakeState::Walk:
+		ShakeClass = WalkCameraShake;
+		break;
+	case EShakeState::Sprint:
+		ShakeClass = SprintCameraShake;
+		break;
+	default:
+		break;
 	}
-	else
+
+	if (ShakeClass != nullptr)
 	{
-		StartCameraShake(IdleCameraShake);
+		ActiveCameraShake = StartCameraShake(ShakeClass);
 	}
 }
 
-void AExhibitionCameraManager::ToggleCustomBlur(FTViewTarget& OutVT, const float BlurAmountOffset, const float BlurDistortionOffset, const bool bAdd)
+void AExhibitionCameraManager::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
 {
-	float BlurAmount = BlurAmountOffset;
-	float BlurDistortion = BlurDistortionOffset;
-	
-	if (!bAdd)
+	Setup(Cast<AExhibitionCharacter>(NewPawn));
+}
+
+void AExhibitionCameraManager::HandleMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	UpdateCameraShake();
+}
+
+void AExhibitionCameraManager::HandleLocomotionChanged()
+{
+	UpdateCameraShake();
+}
+
+void AExhibitionCameraManager::HandleStartCrouch()
+{
+	bCrouching = true;
+	EffectStack.Push(ExhibitionCameraEffects::Crouch, MakeCrouchEffect());
+}
+
+void AExhibitionCameraManager::HandleEndCrouch()
+{
+	bCrouching = false;
+	EffectStack.Release(ExhibitionCameraEffects::Crouch);
+}
+
+void AExhibitionCameraManager::HandleEnterHook()
+{
+	bHooking = true;
+}
+
+void AExhibitionCameraManager::HandleExitHook()
+{
+	bHooking = false;
+	EffectStack.Release(ExhibitionCameraEffects::Hook);
+}
+
+void AExhibitionCameraManager::HandleEnterRope()
+{
+	EffectStack.Push(ExhibitionCameraEffects::Rope, MakeRopeEffect());
+}
+
+void AExhibitionCameraManager::HandleExitRope()
+{
+	EffectStack.Release(ExhibitionCameraEffects::Rope);
+}
+
+void AExhibitionCameraManager::InitializeFor(APlayerController* PC)
+{
+	Super::InitializeFor(PC);
+
+	BakeCurves();
+	PreloadAssets();
+
+	if (PC != nullptr)
 	{
-		BlurAmount = - BlurAmountOffset;
-		BlurDistortion = -BlurDistortionOffset;
+		PC->OnPossessedPawnChanged.AddUniqueDynamic(this, &AExhibitionCameraManager::HandlePossessedPawnChanged);
+		Setup(Cast<AExhibitionCharacter>(PC->GetPawn()));
 	}
-	
-	OutVT.POV.PostProcessSettings.bOverride_MotionBlurAmount = bAdd;
-	OutVT.POV.PostProcessSettings.bOverride_MotionBlurMax = bAdd;
-	OutVT.POV.PostProcessSettings.MotionBlurAmount += BlurAmount;
-	OutVT.POV.PostProcessSettings.MotionBlurMax += BlurDistortion;
 }
 
-void AExhibitionCameraManager::TogglePostProcessMaterial(FTViewTarget& OutVT, UMaterialInstance* Material, const bool bAdd)
+void AExhibitionCameraManager::BakeCurves()
 {
-	if (!OutVT.POV.PostProcessSettings.WeightedBlendables.Array.IsValidIndex(0))
+	BakedCrouchLocationCurve.Bake(CrouchLocationCurve, FExhibitionBakedCurve::DefaultResolution, TEXT("CrouchLocationCurve"));
+	BakedCrouchFOVCurve.Bake(CrouchFOVCurve, FExhibitionBakedCurve::DefaultResolution, TEXT("CrouchFOVCurve"));
+	BakedRopeFOVCurve.Bake(RopeFOVCurve, FExhibitionBakedCurve::DefaultResolution, TEXT("RopeFOVCurve"));
+
+	CrouchLocationRatio = BakedCrouchLocationCurve.Eval(CrouchLocationTime / CrouchLocationDuration);
+}
+
+void AExhibitionCameraManager::PreloadAssets()
+{
+	if (AssetsHandle.IsValid())
 	{
-		OutVT.POV.PostProcessSettings.WeightedBlendables.Array.EmplaceAt(0, FWeightedBlendable(0.f, Material));
+		return;
 	}
-	else
+
+	TArray<FSoftObjectPath> Assets;
+	for (const TSoftObjectPtr<UMaterialInstance>* Asset : {&HookSpeedLines, &RopeSpeedLines})
 	{
-		OutVT.POV.PostProcessSettings.WeightedBlendables.Array[0] = FWeightedBlendable(0.f, Material);
+		if (!Asset->IsNull())
+		{
+			Assets.AddUnique(Asset->ToSoftObjectPath());
+		}
 	}
 
-	float MaterialWeight = 0.f;
-	if (bAdd)
+	if (Assets.IsEmpty())
 	{
-		MaterialWeight = 1.f;	
+		return;
 	}
 
-	OutVT.POV.PostProcessSettings.WeightedBlendables.Array[0].Weight = MaterialWeight;
+	AssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Assets, FStreamableDelegate::CreateUObject(this, &AExhibitionCameraManager::OnAssetsLoaded), FStreamableManager::AsyncLoadHighPriority);
 }
 
-float AExhibitionCameraManager::CalculateFov(const float Delta, const float MaxDuration, const float Target, const FRuntimeFloatCurve& Curve)
+void AExhibitionCameraManager::OnAssetsLoaded()
 {
-	CurrentFOVTime = FMath::Clamp(CurrentFOVTime + Delta, 0.f, MaxDuration);
-	const float FOVRatio = Curve.GetRichCurveConst()->Eval(CurrentFOVTime / MaxDuration);
-	const float NewFOV = FMath::Lerp(0.f, Target, FOVRatio);
-	return NewFOV;
+	HookSpeedLinesMaterial = HookSpeedLines.Get();
+	RopeSpeedLinesMaterial = RopeSpeedLines.Get();
+
+	// Effects pushed while streaming start showing their material now
+	EffectStack.SetMaterial(ExhibitionCameraEffects::Hook, HookSpeedLinesMaterial);
+	EffectStack.SetMaterial(ExhibitionCameraEffects::Rope, RopeSpeedLinesMaterial);
 }
 
-void AExhibitionCameraManager::InitializeFor(APlayerController* PC)
+UMaterialInstance* AExhibitionCameraManager::GetResidentMaterial(const TSoftObjectPtr<UMaterialInstance>& Asset, UMaterialInstance* Material) const
 {
-	Super::InitializeFor(PC);
+	if (Material == nullptr && !Asset.IsNull())
+	{
+		EXHIBITION_MOVEMENT_COUNT(CameraAssetMisses, 1);
+		UE_LOG(LogExhibitionCamera, Warning, TEXT("Frame %llu: %s is not loaded yet"), GFrameCounter, *Asset.ToString());
+	}
 
-	Setup();
+	return Material;
 }
@@ -4,9 +4,12 @@
 #include "Characters/ExhibitionCharacter.h"
 
 #include "Camera/CameraComponent.h"
+#include "Components/ExhibitionHookLineComponent.h"
 #include "Components/ExhibitionMovementComponent.h"
+#include "Components/ExhibitionSpringArmComponent.h"
+#include "Engine/StaticMesh.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "GameFramework/SpringArmComponent.h"
+#include "UObject/ConstructorHelpers.h"
 
 // Sets default values
 AExhibitionCharacter::AExhibitionCharacter(const FObjectInitializer& Initializer) :
@@ -17,12 +20,21 @@ AExhibitionCharacter::AExhibitionCharacter(const FObjectInitializer& Initializer
 	ExhibitionMovementComponent = Cast<UExhibitionMovementComponent>(GetCharacterMovement());
 	ExhibitionMovementComponent->SetIsReplicated(true);
 
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("Camera Boom"));
+	CameraBoom = CreateDefaultSubobject<UExhibitionSpringArmComponent>(TEXT("Camera Boom"));
 	CameraBoom->bUsePawnControlRotation = true;
 	CameraBoom->SetupAttachment(GetRootComponent());
 
 	CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera Component"));
 	CameraComponent->SetupAttachment(CameraBoom);
+
+	// Thin cylinder stretched from the hand to the hook, the engine shape is modeled along Z
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> HookLineMesh(TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+	HookLine = CreateDefaultSubobject<UExhibitionHookLineComponent>(TEXT("Hook Line"));
+	HookLine->SetupAttachment(GetMesh());
+	HookLine->SetStaticMesh(HookLineMesh.Object);
+	HookLine->SetForwardAxis(ESplineMeshAxis::Z, false);
+	HookLine->SetStartScale(FVector2D(0.02f), false);
+	HookLine->SetEndScale(FVector2D(0.02f), false);
 	
 	bUseControllerRotationYaw = false;
 	bUseControllerRotationPitch = false;
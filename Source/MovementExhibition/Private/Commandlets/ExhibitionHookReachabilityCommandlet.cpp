@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/ExhibitionHookReachabilityCommandlet.h"
+
+#include "CollisionShape.h"
+#include "EngineUtils.h"
+#include "Data/ExhibitionHookReachabilityData.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHookReachability, Log, All);
+
+namespace ExhibitionHookReachability
+{
+	// Spots spread over the cell, in cell units from the center. A hook is listed when any spot the capsule
+	// fits in sees it, so the list covers every place of the cell a character can stand.
+	static const FVector SampleOffsets[] = {
+		FVector(0.f, 0.f, 0.f),
+		FVector(0.f, 0.f, 0.25f),
+		FVector(0.f, 0.f, -0.25f),
+		FVector(0.25f, 0.f, 0.f),
+		FVector(-0.25f, 0.f, 0.f),
+		FVector(0.f, 0.25f, 0.f),
+		FVector(0.f, -0.25f, 0.f),
+		FVector(0.375f, 0.375f, 0.f),
+		FVector(0.375f, -0.375f, 0.f),
+		FVector(-0.375f, 0.375f, 0.f),
+		FVector(-0.375f, -0.375f, 0.f),
+	};
+}
+
+UExhibitionHookReachabilityCommandlet::UExhibitionHookReachabilityCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UExhibitionHookReachabilityCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapName;
+	FString TagName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName) || !FParse::Value(*Params, TEXT("Tag="), TagName))
+	{
+		UE_LOG(LogHookReachability, Error, TEXT("Usage: -run=ExhibitionHookReachability -Map=<LongPackageName> -Tag=<HookTag> [-CellSize=200] [-MaxDistance=5000] [-Radius=34] [-HalfHeight=88] [-MaxCells=16777216]"));
+		return 1;
+	}
+
+	float CellSize = 200.f;
+	float MaxDistance = 5000.f;
+	float Radius = 34.f;
+	float HalfHeight = 88.f;
+	int32 MaxCells = 1 << 24;
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("MaxDistance="), MaxDistance);
+	FParse::Value(*Params, TEXT("Radius="), Radius);
+	FParse::Value(*Params, TEXT("HalfHeight="), HalfHeight);
+	FParse::Value(*Params, TEXT("MaxCells="), MaxCells);
+	CellSize = FMath::Max(CellSize, 10.f);
+	MaxCells = FMath::Clamp(MaxCells, 1, MAX_int32 - 1);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = (MapPackage != nullptr)? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogHookReachability, Error, TEXT("Unable to load map %s"), *MapName);
+		return 1;
+	}
+
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValues;
+		InitValues.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true);
+		World->InitWorld(InitValues);
+	}
+	World->UpdateWorldComponents(true, false);
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+	const FName HookTag(*TagName);
+	TArray<AActor*> Hooks;
+	FBox HookBounds(ForceInit);
+	FBox CollisionBounds(ForceInit);
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (It->ActorHasTag(HookTag))
+		{
+			Hooks.Add(*It);
+			HookBounds += It->GetActorLocation();
+		}
+		else if (It->GetActorEnableCollision())
+		{
+			CollisionBounds += It->GetComponentsBoundingBox(false);
+		}
+	}
+
+	// Cells further than MaxDistance from every hook have nothing to list, and sky domes or kill volumes
+	// can make the collision bounds arbitrarily large: only bake where both overlap
+	const FBox PlayableBounds = (HookBounds.IsValid && CollisionBounds.IsValid)? CollisionBounds.Overlap(HookBounds.ExpandBy(MaxDistance)) : FBox(ForceInit);
+
+	if (Hooks.IsEmpty() || !PlayableBounds.IsValid)
+	{
+		UE_LOG(LogHookReachability, Warning, TEXT("Nothing to bake in %s (hooks: %d)"), *MapName, Hooks.Num());
+		World->RemoveFromRoot();
+		return 0;
+	}
+
+	if (Hooks.Num() > MAX_uint16)
+	{
+		UE_LOG(LogHookReachability, Error, TEXT("Too many hooks in %s: %d"), *MapName, Hooks.Num());
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	const FString PackageName = UExhibitionHookReachabilityData::GetPackageNameForWorld(MapPackage->GetName());
+	UPackage* DataPackage = CreatePackage(*PackageName);
+	UExhibitionHookReachabilityData* Data = NewObject<UExhibitionHookReachabilityData>(
+		DataPackage,
+		*UExhibitionHookReachabilityData::GetAssetNameForWorld(MapPackage->GetName()),
+		RF_Public | RF_Standalone
+	);
+
+	Data->HookTag = HookTag;
+	Data->MaxHookDistance = MaxDistance;
+	Data->CapsuleRadius = Radius;
+	Data->CapsuleHalfHeight = HalfHeight;
+	Data->Origin = PlayableBounds.Min;
+
+	// Grow the cells until the grid fits the budget, the cell index and the cell starts are 32 bits
+	const float RequestedCellSize = CellSize;
+	for (;;)
+	{
+		const FVector Extent = (PlayableBounds.GetSize() / CellSize).ComponentMin(FVector(static_cast<double>(MaxCells)));
+		Data->Dimensions = FIntVector(FMath::CeilToInt32(Extent.X), FMath::CeilToInt32(Extent.Y), FMath::CeilToInt32(Extent.Z)).ComponentMax(FIntVector(1));
+		const int64 NumCells = Data->GetNumCells();
+		if (NumCells <= MaxCells)
+		{
+			break;
+		}
+
+		CellSize *= FMath::Max(FMath::Pow(static_cast<float>(NumCells) / MaxCells, 1.f / 3.f), 1.01f);
+	}
+	Data->CellSize = CellSize;
+
+	if (CellSize > RequestedCellSize)
+	{
+		UE_LOG(LogHookReachability, Warning, TEXT("%s does not fit in %d cells of %.0f, baking with cells of %.0f"), *MapName, MaxCells, RequestedCellSize, CellSize);
+	}
+
+	for (const AActor* Hook : Hooks)
+	{
+		Data->HookNames.Add(Hook->GetFName());
+	}
+
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(Radius, HalfHeight);
+	const FName ProfileName = TEXT("BlockAll");
+	// Measured from the cell center, a hook in range of any point of the cell must pass
+	const float CellHalfDiagonal = 0.5f * CellSize * UE_SQRT_3;
+	const float MaxDistanceSqr = FMath::Square(MaxDistance + CellHalfDiagonal);
+	const int32 NumCells = static_cast<int32>(Data->GetNumCells());
+	Data->CellStarts.Reserve(NumCells + 1);
+	Data->BakedCells.Init(false, NumCells);
+	int32 NumUnbaked = 0;
+
+	TArray<FVector, TInlineAllocator<UE_ARRAY_COUNT(ExhibitionHookReachability::SampleOffsets)>> FreeSamples;
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+	{
+		Data->CellStarts.Add(Data->CellHooks.Num());
+
+		// Cells the capsule fits nowhere in carry no data, so the runtime searches the grid there instead of
+		// trusting an empty list
+		const FVector CellCenter = Data->GetCellCenter(CellIndex);
+		FreeSamples.Reset();
+		for (const FVector& Offset : ExhibitionHookReachability::SampleOffsets)
+		{
+			const FVector SampleLocation = CellCenter + Offset * CellSize;
+			if (!World->OverlapBlockingTestByProfile(SampleLocation, FQuat::Identity, ProfileName, Capsule))
+			{
+				FreeSamples.Add(SampleLocation);
+			}
+		}
+
+		if (FreeSamples.IsEmpty())
+		{
+			++NumUnbaked;
+			continue;
+		}
+
+		Data->BakedCells[CellIndex] = true;
+		for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+		{
+			const FVector HookLocation = Hooks[HookIndex]->GetActorLocation();
+			if (FVector::DistSquared(CellCenter, HookLocation) > MaxDistanceSqr)
+			{
+				continue;
+			}
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(HookReachability), false, Hooks[HookIndex]);
+			const bool bVisible = FreeSamples.ContainsByPredicate([&](const FVector& SampleLocation)
+			{
+				return !World->SweepTestByProfile(SampleLocation, HookLocation, FQuat::Identity, ProfileName, Capsule, QueryParams);
+			});
+
+			if (bVisible)
+			{
+				Data->CellHooks.Add(static_cast<uint16>(HookIndex));
+			}
+		}
+
+		if (CellIndex % 10000 == 0)
+		{
+			UE_LOG(LogHookReachability, Display, TEXT("Baked %d / %d cells"), CellIndex, NumCells);
+		}
+	}
+	Data->CellStarts.Add(Data->CellHooks.Num());
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+	const bool bSaved = UPackage::SavePackage(DataPackage, Data, *Filename, SaveArgs);
+
+	UE_LOG(LogHookReachability, Display, TEXT("%s %s: %d cells (%d without data), %d hooks, %d entries"), bSaved? TEXT("Saved") : TEXT("Failed to save"), *Filename, NumCells, NumUnbaked, Hooks.Num(), Data->CellHooks.Num());
+
+	World->RemoveFromRoot();
+	return bSaved? 0 : 1;
+#else
+	return 1;
+#endif
+}
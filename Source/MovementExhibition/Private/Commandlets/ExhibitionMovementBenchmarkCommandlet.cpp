@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/ExhibitionMovementBenchmarkCommandlet.h"
+
+#include "EngineUtils.h"
+#include "Benchmark/ExhibitionBenchmark.h"
+#include "Characters/ExhibitionCharacter.h"
+#include "Components/ExhibitionMovementComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMovementBenchmark, Log, All);
+
+namespace ExhibitionMovementBenchmark
+{
+	static FString GetModeName(const UExhibitionMovementComponent& Movement)
+	{
+		if (Movement.MovementMode == MOVE_Custom)
+		{
+			return StaticEnum<ECustomMovementMode>()->GetNameStringByValue(Movement.CustomMovementMode);
+		}
+
+		return StaticEnum<EMovementMode>()->GetNameStringByValue(Movement.MovementMode);
+	}
+}
+
+UExhibitionMovementBenchmarkCommandlet::UExhibitionMovementBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UExhibitionMovementBenchmarkCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	using namespace ExhibitionBenchmark;
+	using namespace ExhibitionMovementBenchmark;
+
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogMovementBenchmark, Error, TEXT("Usage: -run=ExhibitionMovementBenchmark -nullrhi -Map=<LongPackageName> [-Character=<ClassPath>] [-Scenario=All] [-Count=32] [-Frames=1800] [-DeltaTime=0.0166] [-Output=<File.json>]"));
+		return 1;
+	}
+
+	FString CharacterClassPath;
+	FString ScenarioFilter = TEXT("All");
+	int32 Count = 32;
+	int32 Frames = 1800;
+	float DeltaTime = 1.f / 60.f;
+	FString OutputFile = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("MovementBenchmark_%s.json"), *FDateTime::Now().ToString());
+	FParse::Value(*Params, TEXT("Character="), CharacterClassPath);
+	FParse::Value(*Params, TEXT("Scenario="), ScenarioFilter);
+	FParse::Value(*Params, TEXT("Count="), Count);
+	FParse::Value(*Params, TEXT("Frames="), Frames);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+	FParse::Value(*Params, TEXT("Output="), OutputFile);
+	Count = FMath::Max(Count, 1);
+	Frames = FMath::Max(Frames, 1);
+	DeltaTime = FMath::Max(DeltaTime, 0.001f);
+
+	TSubclassOf<AExhibitionCharacter> CharacterClass = AExhibitionCharacter::StaticClass();
+	if (!CharacterClassPath.IsEmpty())
+	{
+		CharacterClass = LoadClass<AExhibitionCharacter>(nullptr, *CharacterClassPath);
+		if (CharacterClass == nullptr)
+		{
+			UE_LOG(LogMovementBenchmark, Error, TEXT("Unable to load character class %s"), *CharacterClassPath);
+			return 1;
+		}
+	}
+
+	TArray<FScenario> Scenarios = MakeScenarios();
+	if (ScenarioFilter != TEXT("All"))
+	{
+		Scenarios.RemoveAll([&ScenarioFilter](const FScenario& Scenario) { return ScenarioFilter != Scenario.Name; });
+		if (Scenarios.IsEmpty())
+		{
+			UE_LOG(LogMovementBenchmark, Error, TEXT("Unknown scenario %s"), *ScenarioFilter);
+			return 1;
+		}
+	}
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = (MapPackage != nullptr)? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogMovementBenchmark, Error, TEXT("Unable to load map %s"), *MapName);
+		return 1;
+	}
+
+	// Game world so the hook and rope subsystems are created like they are at runtime
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+	if (!World->bIsWorldInitialized)
+	{
+		UWorld::InitializationValues InitValues;
+		InitValues.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true);
+		World->InitWorld(InitValues);
+	}
+	World->UpdateWorldComponents(true, false);
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	if (!World->GetBegunPlay())
+	{
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	FTransform SpawnOrigin = FTransform::Identity;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		SpawnOrigin = It->GetActorTransform();
+		break;
+	}
+
+	struct FBenchmarkCharacter
+	{
+		AExhibitionCharacter* Character = nullptr;
+		UExhibitionMovementComponent* Movement = nullptr;
+		TOptional<FScenarioPlayer> Input;
+	};
+
+	// Characters are spread on a square around the spawn point and ticked manually, one after the other
+	TArray<FBenchmarkCharacter> Characters;
+	const int32 Side = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Count)));
+	const float Spacing = 300.f;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Offset((Index % Side - Side / 2) * Spacing, (Index / Side - Side / 2) * Spacing, 0.f);
+		const FTransform SpawnTransform(SpawnOrigin.GetRotation(), SpawnOrigin.TransformPosition(Offset));
+		AExhibitionCharacter* Character = World->SpawnActor<AExhibitionCharacter>(CharacterClass, SpawnTransform, SpawnParams);
+		UExhibitionMovementComponent* Movement = (Character != nullptr)? Character->GetExhibitionMovComponent() : nullptr;
+		if (Movement == nullptr)
+		{
+			continue;
+		}
+
+		// No controller in a commandlet
+		Movement->bRunPhysicsWithNoController = true;
+		Movement->SetComponentTickEnabled(false);
+
+		FBenchmarkCharacter& Entry = Characters.AddDefaulted_GetRef();
+		Entry.Character = Character;
+		Entry.Movement = Movement;
+		Entry.Input.Emplace(Scenarios[Index % Scenarios.Num()]);
+	}
+
+	if (Characters.IsEmpty())
+	{
+		UE_LOG(LogMovementBenchmark, Error, TEXT("Unable to spawn %s in %s"), *CharacterClass->GetName(), *MapName);
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	UE_LOG(LogMovementBenchmark, Display, TEXT("Running %d frames with %d characters in %s"), Frames, Characters.Num(), *MapName);
+
+	TMap<FString, TArray<double>> SamplesPerMode;
+	for (int32 Frame = 0; Frame < Frames; ++Frame)
+	{
+		// Code gated on the frame counter has to see frames advance
+		++GFrameCounter;
+		World->GetTimerManager().Tick(DeltaTime);
+
+		for (FBenchmarkCharacter& Entry : Characters)
+		{
+			Entry.Input->Tick(*Entry.Character, *Entry.Movement, DeltaTime);
+
+			const FString ModeName = GetModeName(*Entry.Movement);
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Entry.Movement->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+			const double Microseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+			SamplesPerMode.FindOrAdd(ModeName).Add(Microseconds);
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Map"), MapName);
+	Report->SetStringField(TEXT("Character"), CharacterClass->GetPathName());
+	Report->SetStringField(TEXT("Scenario"), ScenarioFilter);
+	Report->SetNumberField(TEXT("Characters"), Characters.Num());
+	Report->SetNumberField(TEXT("Frames"), Frames);
+	Report->SetNumberField(TEXT("DeltaTime"), DeltaTime);
+	Report->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+
+	TSharedRef<FJsonObject> Modes = MakeShared<FJsonObject>();
+	for (TPair<FString, TArray<double>>& Pair : SamplesPerMode)
+	{
+		TArray<double>& Samples = Pair.Value;
+		Samples.Sort();
+
+		double Total = 0.0;
+		for (const double Sample : Samples)
+		{
+			Total += Sample;
+		}
+
+		const double Mean = Total / Samples.Num();
+		const double P50 = Percentile(Samples, 0.5);
+		const double P99 = Percentile(Samples, 0.99);
+
+		TSharedRef<FJsonObject> Mode = MakeShared<FJsonObject>();
+		Mode->SetNumberField(TEXT("Ticks"), Samples.Num());
+		Mode->SetNumberField(TEXT("MeanUs"), Mean);
+		Mode->SetNumberField(TEXT("P50Us"), P50);
+		Mode->SetNumberField(TEXT("P99Us"), P99);
+		Mode->SetNumberField(TEXT("MaxUs"), Samples.Last());
+		Modes->SetObjectField(Pair.Key, Mode);
+
+		UE_LOG(LogMovementBenchmark, Display, TEXT("%-12s ticks %8d  mean %8.2fus  p50 %8.2fus  p99 %8.2fus"), *Pair.Key, Samples.Num(), Mean, P50, P99);
+	}
+	Report->SetObjectField(TEXT("Modes"), Modes);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputFile), true);
+	const bool bSaved = FFileHelper::SaveStringToFile(Json, *OutputFile);
+	UE_LOG(LogMovementBenchmark, Display, TEXT("%s %s"), bSaved? TEXT("Saved") : TEXT("Failed to save"), *OutputFile);
+
+	for (const FBenchmarkCharacter& Entry : Characters)
+	{
+		Entry.Character->Destroy();
+	}
+
+	World->RemoveFromRoot();
+	return bSaved? 0 : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ExhibitionHookLineComponent.h"
+
+UExhibitionHookLineComponent::UExhibitionHookLineComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// Spline points are given in world space
+	SetUsingAbsoluteLocation(true);
+	SetUsingAbsoluteRotation(true);
+	SetUsingAbsoluteScale(true);
+
+	SetMobility(EComponentMobility::Movable);
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+	CastShadow = false;
+	bHiddenInGame = true;
+}
+
+void UExhibitionHookLineComponent::ShowLine()
+{
+	SetHiddenInGame(false);
+}
+
+void UExhibitionHookLineComponent::HideLine()
+{
+	SetHiddenInGame(true);
+
+	// Collapsed, so showing it again does not flash the previous hook for a frame
+	const FVector Start = GetStartPosition();
+	SetStartAndEnd(Start, FVector::ZeroVector, Start, FVector::ZeroVector, true);
+}
+
+void UExhibitionHookLineComponent::UpdateLine(const FVector& Start, const FVector& End)
+{
+	const FVector Chord = End - Start;
+	const float Sag = ComputeSag(Chord.Size(), Slack);
+
+	// Hermite midpoint is (P0 + P1) / 2 + (T0 - T1) / 8, offsetting the tangents by 4 * Sag drops it by Sag
+	const FVector SagOffset = FVector::UpVector * (4.f * Sag);
+	SetStartAndEnd(Start, Chord - SagOffset, End, Chord + SagOffset, true);
+}
+
+float UExhibitionHookLineComponent::ComputeSag(const float Span, const float Slack)
+{
+	if (Span <= UE_KINDA_SMALL_NUMBER || Slack <= 0.f)
+	{
+		return 0.f;
+	}
+
+	// Shallow catenary: Length ~= Span + 8 * Sag^2 / (3 * Span)
+	const float ExtraLength = Span * Slack;
+	return FMath::Sqrt(3.f * Span * ExtraLength / 8.f);
+}
@@ -6,9 +6,12 @@
 #include "CableComponent.h"
 #include "Characters/ExhibitionCharacter.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/ExhibitionHookLineComponent.h"
+#include "Components/ExhibitionNetUpdatePolicy.h"
 #include "GameFramework/Character.h"
-#include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Stats/ExhibitionMovementStats.h"
 
 #define SHAPES_DEBUG_DURATION 5.f
 #define LINE(Start, End, Color) DrawDebugLine(GetWorld(), Start, End, Color, false, SHAPES_DEBUG_DURATION)
@@ -28,6 +31,27 @@ static TAutoConsoleVariable<bool> CVarDebugMovement(
 	ECVF_Default
 );
 
+static TAutoConsoleVariable<bool> CVarCombineTravelMoves(
+	TEXT("MovExhibition.Net.CombineTravelMoves"),
+	true,
+	TEXT("Merge consecutive saved moves during steady hook and rope travel"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarCombineTolerance(
+	TEXT("MovExhibition.Net.CombineTolerance"),
+	2.f,
+	TEXT("Max distance between where two slide or travel moves ended and where replaying them as one is expected to end"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<bool> CVarSlideReuseFloor(
+	TEXT("MovExhibition.Slide.ReuseFloor"),
+	true,
+	TEXT("Answer slide surface checks from the current floor when it is fresh instead of tracing"),
+	ECVF_Default
+);
+
 #pragma region Saved Move
 
 UExhibitionMovementComponent::FSavedMove_Exhibition::FSavedMove_Exhibition() { }
@@ -50,47 +74,133 @@ bool UExhibitionMovementComponent::FSavedMove_Exhibition::CanCombineWith(const F
 	{
 		return false;
 	}
+
+	if (Saved_bCustomPressedJump != NewMoveCasted->Saved_bCustomPressedJump || Saved_bPrevWantsToCrouch != NewMoveCasted->Saved_bPrevWantsToCrouch)
+	{
+		return false;
+	}
+
+	if (Saved_bReachedDestination != NewMoveCasted->Saved_bReachedDestination || Saved_FlyingDiveCount != NewMoveCasted->Saved_FlyingDiveCount)
+	{
+		return false;
+	}
+
+	if (Saved_Target != NewMoveCasted->Saved_Target)
+	{
+		return false;
+	}
+
+	// Travel data only changes when a travel starts or ends
+	if (Saved_TravelName != NewMoveCasted->Saved_TravelName || !Saved_TravelDestination.Equals(NewMoveCasted->Saved_TravelDestination))
+	{
+		return false;
+	}
+
+	if (Saved_bSteadyTravel != NewMoveCasted->Saved_bSteadyTravel || Saved_bSliding != NewMoveCasted->Saved_bSliding)
+	{
+		return false;
+	}
+
+	if (Saved_bSteadyTravel)
+	{
+		if (!Acceleration.Equals(NewMoveCasted->Acceleration) || !HasSameRootMotionSources(*NewMoveCasted))
+		{
+			return false;
+		}
+
+		// Leave the arrival to a regular move, a merged one could step over the tolerance check.
+		// The new move has not run yet, so where it ends is extrapolated from where it starts
+		const FVector ProjectedLocation = SavedLocation + NewMoveCasted->StartVelocity * NewMoveCasted->DeltaTime;
+		const float ArrivalDistance = Saved_TravelTolerance + NewMoveCasted->StartVelocity.Size() * NewMoveCasted->DeltaTime;
+		if (FVector::DistSquared(ProjectedLocation, Saved_TravelDestination) <= FMath::Square(ArrivalDistance))
+		{
+			return false;
+		}
+	}
+
+	if (Saved_bSliding && !Acceleration.Equals(NewMoveCasted->Acceleration))
+	{
+		return false;
+	}
+
+	if ((Saved_bSteadyTravel || Saved_bSliding) && !IsCombinedMoveWithinTolerance(*NewMoveCasted))
+	{
+		return false;
+	}
 	
 	return FSavedMove_Character::CanCombineWith(NewMove, InCharacter, MaxDelta);
 }
 
-void UExhibitionMovementComponent::FSavedMove_Exhibition::Clear()
+void UExhibitionMovementComponent::FSavedMove_Exhibition::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
 {
-	FSavedMove_Character::Clear();
+	FSavedMove_Character::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
 
-	Saved_bWantsToSprint = 0;
-	Saved_bPrevWantsToCrouch = 0;
-	Saved_bWantsToDive = 0;
-	Saved_FlyingDiveCount = 0;
-	Saved_bWantsToHook = 0;
-	Saved_bReachedDestination = 0;
-	Saved_bCustomPressedJump = 0;
+	// The combined move is replayed from the old move's start, so the travel root motion has to be too
+	const FSavedMove_Exhibition* OldMoveCasted = static_cast<const FSavedMove_Exhibition*>(OldMove);
+	if (Saved_bSteadyTravel && OldMoveCasted->Saved_bSteadyTravel && OldMove->SavedRootMotion.HasActiveRootMotionSources())
+	{
+		if (UCharacterMovementComponent* MovComponent = InCharacter->GetCharacterMovement())
+		{
+			MovComponent->CurrentRootMotion.UpdateStateFrom(OldMove->SavedRootMotion);
+		}
+	}
 }
 
-uint8 UExhibitionMovementComponent::FSavedMove_Exhibition::GetCompressedFlags() const
+bool UExhibitionMovementComponent::FSavedMove_Exhibition::IsCombinedMoveWithinTolerance(const FSavedMove_Exhibition& NewMove) const
 {
-	uint8 CompressedFlags = FSavedMove_Character::GetCompressedFlags();
-	if (Saved_bWantsToSprint)
+	if (DeltaTime <= 0.f)
 	{
-		CompressedFlags |= FLAG_Custom_0;
+		return false;
 	}
 
-	if (Saved_bWantsToDive)
-	{
-		CompressedFlags |= FLAG_Custom_1;
-	}
+	// The new move has not run yet: carry the pending move's acceleration over it to guess where it ends
+	const FVector VelocityRate = (SavedVelocity - StartVelocity) / DeltaTime;
+	const FVector EndVelocity = NewMove.StartVelocity + VelocityRate * NewMove.DeltaTime;
+	const FVector SteppedLocation = SavedLocation + (NewMove.StartVelocity + EndVelocity) * 0.5f * NewMove.DeltaTime;
+
+	// Steady moves integrate their velocity close to linearly, one trapezoid over both moves approximates the replay
+	const float CombinedDeltaTime = DeltaTime + NewMove.DeltaTime;
+	const FVector CombinedLocation = StartLocation + (StartVelocity + EndVelocity) * 0.5f * CombinedDeltaTime;
+	return FVector::DistSquared(CombinedLocation, SteppedLocation) <= FMath::Square(CVarCombineTolerance->GetFloat());
+}
 
-	if (Saved_bWantsToHook)
+bool UExhibitionMovementComponent::FSavedMove_Exhibition::HasSameRootMotionSources(const FSavedMove_Exhibition& NewMove) const
+{
+	const TArray<TSharedPtr<FRootMotionSource>>& Sources = SavedRootMotion.RootMotionSources;
+	const TArray<TSharedPtr<FRootMotionSource>>& NewSources = NewMove.SavedRootMotion.RootMotionSources;
+	if (Sources.Num() != NewSources.Num())
 	{
-		CompressedFlags |= FLAG_Custom_2;
+		return false;
 	}
 
-	if (Saved_bCustomPressedJump)
+	for (int32 i = 0; i < Sources.Num(); ++i)
 	{
-		CompressedFlags |= FLAG_JumpPressed; 
+		if (!Sources[i].IsValid() || !NewSources[i].IsValid() || Sources[i]->LocalID != NewSources[i]->LocalID)
+		{
+			return false;
+		}
 	}
 
-	return CompressedFlags;
+	return true;
+}
+
+void UExhibitionMovementComponent::FSavedMove_Exhibition::Clear()
+{
+	FSavedMove_Character::Clear();
+
+	Saved_bWantsToSprint = 0;
+	Saved_bPrevWantsToCrouch = 0;
+	Saved_bWantsToDive = 0;
+	Saved_FlyingDiveCount = 0;
+	Saved_bWantsToHook = 0;
+	Saved_bReachedDestination = 0;
+	Saved_bCustomPressedJump = 0;
+	Saved_Target = nullptr;
+	Saved_bSliding = 0;
+	Saved_bSteadyTravel = 0;
+	Saved_TravelName = NAME_None;
+	Saved_TravelDestination = FVector::ZeroVector;
+	Saved_TravelTolerance = 0.f;
 }
 
 void UExhibitionMovementComponent::FSavedMove_Exhibition::SetMoveFor(ACharacter* C, float InDeltaTime,
@@ -116,6 +226,21 @@ void UExhibitionMovementComponent::FSavedMove_Exhibition::SetMoveFor(ACharacter*
 	Saved_bWantsToHook = MovComponent->Safe_bWantsToHook;
 	Saved_bReachedDestination = MovComponent->Safe_bReachedDestination;
 	Saved_bCustomPressedJump = MovComponent->ExhibitionCharacterRef->bCustomPressedJump;
+
+	Saved_bSliding = MovComponent->IsSliding();
+	if (MovComponent->TravelData.IsSet())
+	{
+		Saved_TravelName = MovComponent->TravelData->TravelName;
+		Saved_TravelDestination = MovComponent->TravelData->Destination;
+		Saved_TravelTolerance = MovComponent->TravelData->bHasTolerance? MovComponent->TravelData->Tolerance : 0.f;
+	}
+
+	// Root motion moves are never combined by default, the travel sources can be rolled back in CombineWith
+	Saved_bSteadyTravel = CVarCombineTravelMoves->GetBool() && MovComponent->IsInSteadyTravel();
+	if (Saved_bSteadyTravel)
+	{
+		bForceNoCombine = false;
+	}
 }
 
 void UExhibitionMovementComponent::FSavedMove_Exhibition::PrepMoveFor(ACharacter* C)
@@ -140,10 +265,102 @@ void UExhibitionMovementComponent::FSavedMove_Exhibition::PrepMoveFor(ACharacter
 	MovComponent->Safe_bWantsToHook = Saved_bWantsToHook;
 	MovComponent->Safe_bReachedDestination = Saved_bReachedDestination;
 	MovComponent->ExhibitionCharacterRef->bCustomPressedJump = Saved_bCustomPressedJump;
+
+	// Replays commit the hook in the move that originally picked it, whatever the async search would do now
+	MovComponent->Safe_ClientTarget = Saved_Target;
+}
+
+void UExhibitionMovementComponent::FSavedMove_Exhibition::PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode)
+{
+	FSavedMove_Character::PostUpdate(C, PostUpdateMode);
+
+	if (C == nullptr || PostUpdateMode != PostUpdate_Record)
+	{
+		return;
+	}
+
+	// The target is only known once the move selected it
+	const UExhibitionMovementComponent* MovComponent = Cast<UExhibitionMovementComponent>(C->GetMovementComponent());
+	if (MovComponent != nullptr)
+	{
+		Saved_Target = (MovComponent->CurrentHook != nullptr)? MovComponent->CurrentHook.Get() : MovComponent->CurrentRope.Get();
+	}
 }
 
 #pragma endregion 
 
+#pragma region Network Move Data
+
+void UExhibitionMovementComponent::FNetworkMoveData_Exhibition::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_Exhibition& ExhibitionMove = static_cast<const FSavedMove_Exhibition&>(ClientMove);
+
+	ExhibitionFlags = 0;
+	ExhibitionFlags |= ExhibitionMove.Saved_bWantsToSprint? FLAG_WantsToSprint : 0;
+	ExhibitionFlags |= ExhibitionMove.Saved_bWantsToDive? FLAG_WantsToDive : 0;
+	ExhibitionFlags |= ExhibitionMove.Saved_bWantsToHook? FLAG_WantsToHook : 0;
+	ExhibitionFlags |= ExhibitionMove.Saved_bCustomPressedJump? FLAG_CustomPressedJump : 0;
+	ExhibitionFlags |= ExhibitionMove.Saved_bPrevWantsToCrouch? FLAG_PrevWantsToCrouch : 0;
+	ExhibitionFlags |= ExhibitionMove.Saved_bReachedDestination? FLAG_ReachedDestination : 0;
+	ExhibitionFlags |= FMath::Clamp(ExhibitionMove.Saved_FlyingDiveCount, 0, 3) << FLAG_FlyingDiveCountShift;
+
+	Target = ExhibitionMove.Saved_Target.Get();
+}
+
+bool UExhibitionMovementComponent::FNetworkMoveData_Exhibition::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// Pending and old moves travel in the same packet as the new move, which is always serialized first:
+	// most of the time they carry the same state and a single bit is enough
+	const FNetworkMoveData_Exhibition* Baseline = nullptr;
+	if (MoveType != ENetworkMoveType::NewMove)
+	{
+		Baseline = static_cast<const FNetworkMoveData_Exhibition*>(CharacterMovement.GetNetworkMoveDataContainer().GetNewMoveData());
+	}
+
+	if (Baseline != nullptr)
+	{
+		uint8 bSameAsBaseline = Ar.IsSaving() && ExhibitionFlags == Baseline->ExhibitionFlags && Target == Baseline->Target;
+		Ar.SerializeBits(&bSameAsBaseline, 1);
+		if (bSameAsBaseline)
+		{
+			ExhibitionFlags = Baseline->ExhibitionFlags;
+			Target = Baseline->Target;
+			return !Ar.IsError();
+		}
+	}
+
+	Ar << ExhibitionFlags;
+
+	uint8 bHasTarget = Target != nullptr;
+	Ar.SerializeBits(&bHasTarget, 1);
+	if (bHasTarget)
+	{
+		// Resolved through the package map, hooks and ropes are stably named level actors
+		UObject* TargetObject = Target;
+		Ar << TargetObject;
+		Target = Cast<AActor>(TargetObject);
+	}
+	else
+	{
+		Target = nullptr;
+	}
+
+	return !Ar.IsError();
+}
+
+UExhibitionMovementComponent::FNetworkMoveDataContainer_Exhibition::FNetworkMoveDataContainer_Exhibition()
+{
+	NewMoveData = &MoveData[0];
+	PendingMoveData = &MoveData[1];
+	OldMoveData = &MoveData[2];
+}
+
+#pragma endregion
+
 #pragma region Network Prediction Data
 
 UExhibitionMovementComponent::FNetworkPredictionData_Client_Exhibition::FNetworkPredictionData_Client_Exhibition(const UCharacterMovementComponent& ClientMovement)
@@ -172,6 +389,10 @@ UExhibitionMovementComponent::UExhibitionMovementComponent()
 	bUseSeparateBrakingFriction = true;
 
 	bCanWalkOffLedgesWhenCrouching = true;
+
+	SetNetworkMoveDataContainer(MoveDataContainer);
+
+	NetUpdatePolicy = CreateDefaultSubobject<UExhibitionNetUpdatePolicy>(TEXT("NetUpdatePolicy"));
 }
 
 void UExhibitionMovementComponent::InitializeComponent()
@@ -189,6 +410,23 @@ void UExhibitionMovementComponent::InitializeComponent()
 	{
 		TravelData.Emplace();
 	}
+	BakedCableCurve.Bake(CableCurve, FExhibitionBakedCurve::DefaultResolution, TEXT("CableCurve"));
+	BindHookCable();
+}
+
+void UExhibitionMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UExhibitionHookSubsystem* HookSubsystem = GetWorld()->GetSubsystem<UExhibitionHookSubsystem>())
+	{
+		HookSubsystem->TrackTag(TagHookName);
+	}
+
+	if (UExhibitionRopeSubsystem* RopeSubsystem = GetWorld()->GetSubsystem<UExhibitionRopeSubsystem>())
+	{
+		RopeSubsystem->TrackTag(TagRopeName);
+	}
 }
 
 FNetworkPredictionData_Client* UExhibitionMovementComponent::GetPredictionData_Client() const
@@ -311,6 +549,8 @@ void UExhibitionMovementComponent::OnMovementModeChanged(EMovementMode PreviousM
 	{
 		EnterRope();
 	}
+
+	UpdateNetUpdateFrequency(0.f, true);
 }
 
 void UExhibitionMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
@@ -336,17 +576,28 @@ void UExhibitionMovementComponent::UpdateCharacterStateBeforeMovement(float Delt
 	// Roll
 	if (Safe_bWantsToDive && CanDive())
 	{
-		PerformDive();
-		Proxy_Dive = !Proxy_Dive;
+		FExhibitionMovementEvent DiveEvent;
+		DiveEvent.Type = EExhibitionMovementEvent::Dive;
+		DiveEvent.Variant = static_cast<uint8>(PerformDive());
+		PushProxyEvent(DiveEvent);
 	}
 
 	// Try hooking
 	// Sim.Proxies get replicated hook state
 	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		if (Safe_bWantsToHook && TryHook())
+		if (!Safe_bWantsToHook)
+		{
+			ResetPendingHookSearch();
+		}
+
+		if (Safe_bWantsToHook && !IsHooking() && (TryClientHook() || TrySearchHook()))
 		{
-			Proxy_FindHook = !Proxy_FindHook;
+			FExhibitionMovementEvent HookEvent;
+			HookEvent.Type = EExhibitionMovementEvent::Hook;
+			HookEvent.Target = CurrentHook;
+			HookEvent.Location = TravelData->Destination;
+			PushProxyEvent(HookEvent);
 			SetMovementMode(MOVE_Custom, CMOVE_Hook);
 		}
 		else if (!Safe_bWantsToHook && IsHooking())
@@ -382,6 +633,7 @@ void UExhibitionMovementComponent::UpdateCharacterStateBeforeMovement(float Delt
 	}
 	
 	Safe_bWantsToDive = false;
+	Safe_ClientTarget = nullptr;
 	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
 }
 
@@ -412,6 +664,8 @@ void UExhibitionMovementComponent::UpdateCharacterStateAfterMovement(float Delta
 		HandleEndTransition(*CurrentTransition.Get());
 		RemoveRootMotionSourceByID(CurrentTransitionId);
 	}
+
+	BroadcastLocomotionChanges();
 }
 
 bool UExhibitionMovementComponent::DoJump(bool bReplayingMoves)
@@ -422,7 +676,10 @@ bool UExhibitionMovementComponent::DoJump(bool bReplayingMoves)
 		if (CharacterOwner->JumpCurrentCount > 1)
 		{
 			PlayMontage(JumpExtraMontage);
-			Proxy_JumpExtra = !Proxy_JumpExtra;
+
+			FExhibitionMovementEvent JumpEvent;
+			JumpEvent.Type = EExhibitionMovementEvent::JumpExtra;
+			PushProxyEvent(JumpEvent);
 		}
 	}
 
@@ -432,15 +689,28 @@ bool UExhibitionMovementComponent::DoJump(bool bReplayingMoves)
 void UExhibitionMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
 {
 	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+
+	UpdateNetUpdateFrequency(DeltaSeconds, false);
 }
 
-void UExhibitionMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+void UExhibitionMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
 {
-	Super::UpdateFromCompressedFlags(Flags);
+	if (const FNetworkMoveData_Exhibition* MoveData = static_cast<const FNetworkMoveData_Exhibition*>(GetCurrentNetworkMoveData()))
+	{
+		Safe_bWantsToSprint = MoveData->HasFlag(FNetworkMoveData_Exhibition::FLAG_WantsToSprint);
+		Safe_bWantsToDive = MoveData->HasFlag(FNetworkMoveData_Exhibition::FLAG_WantsToDive);
+		Safe_bWantsToHook = MoveData->HasFlag(FNetworkMoveData_Exhibition::FLAG_WantsToHook);
+		Safe_bPrevWantsToCrouch = MoveData->HasFlag(FNetworkMoveData_Exhibition::FLAG_PrevWantsToCrouch);
+		ExhibitionCharacterRef->bCustomPressedJump = MoveData->HasFlag(FNetworkMoveData_Exhibition::FLAG_CustomPressedJump);
+
+		// Only taken when it makes the client more restricted, a client cannot grant itself extra dives
+		Safe_FlyingDiveCount = FMath::Max(Safe_FlyingDiveCount, MoveData->GetFlyingDiveCount());
+		Safe_bReachedDestination |= MoveData->HasFlag(FNetworkMoveData_Exhibition::FLAG_ReachedDestination);
+
+		Safe_ClientTarget = MoveData->Target;
+	}
 
-	Safe_bWantsToSprint = (Flags & FSavedMove_Character::CompressedFlags::FLAG_Custom_0) != 0;
-	Safe_bWantsToDive = (Flags & FSavedMove_Character::CompressedFlags::FLAG_Custom_1) != 0;
-	Safe_bWantsToHook = (Flags & FSavedMove_Character::CompressedFlags::FLAG_Custom_2) != 0;
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
 }
 
 bool UExhibitionMovementComponent::IsCustomMovementMode(const ECustomMovementMode& InMovementMode) const
@@ -516,7 +786,10 @@ void UExhibitionMovementComponent::EnterSlide()
 
 	Velocity += Velocity.GetSafeNormal2D() * SlideEnterImpulse;
 
-	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, true, nullptr);
+	if (!IsCurrentFloorFresh())
+	{
+		FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, true, nullptr);
+	}
 
 	OnEnterSlide.Broadcast();
 }
@@ -531,17 +804,56 @@ void UExhibitionMovementComponent::FinishSlide()
 
 bool UExhibitionMovementComponent::CanSlide() const
 {
-	const FVector Start = UpdatedComponent->GetComponentLocation();
-	const FVector End = Start + CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.5f * FVector::DownVector;
-	const FName ProfileName = TEXT("BlockAll");
-	const bool bValidSurface = GetWorld()->LineTraceTestByProfile(Start, End, ProfileName, ExhibitionCharacterRef->GetIgnoreCollisionParams());
+	EXHIBITION_MOVEMENT_SCOPE(CanSlide);
+
 	const bool bEnoughSpeed = Velocity.SizeSquared2D() > FMath::Pow(SlideMinSpeed, 2);
 	
-	return bValidSurface && bEnoughSpeed && IsMovingOnGround();
+	return bEnoughSpeed && IsMovingOnGround() && HasSlideSurface();
+}
+
+bool UExhibitionMovementComponent::HasSlideSurface() const
+{
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const float HalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	// The floor sweep reaches less far than the surface trace, a blocking floor always answers it
+	if (CVarSlideReuseFloor->GetBool() && IsCurrentFloorFresh() && CurrentFloor.bBlockingHit && CurrentFloor.FloorDist <= HalfHeight * 1.5f)
+	{
+		return true;
+	}
+
+	if (SlideSurfaceCache.Frame == GFrameCounter && SlideSurfaceCache.Location.Equals(Start))
+	{
+		return SlideSurfaceCache.bValidSurface;
+	}
+
+	const FVector End = Start + HalfHeight * 2.5f * FVector::DownVector;
+	const FName ProfileName = TEXT("BlockAll");
+	SlideSurfaceCache.bValidSurface = GetWorld()->LineTraceTestByProfile(Start, End, ProfileName, ExhibitionCharacterRef->GetIgnoreCollisionParams());
+	SlideSurfaceCache.Frame = GFrameCounter;
+	SlideSurfaceCache.Location = Start;
+	EXHIBITION_MOVEMENT_COUNT(Traces, 1);
+
+	return SlideSurfaceCache.bValidSurface;
+}
+
+bool UExhibitionMovementComponent::IsCurrentFloorFresh() const
+{
+	if (!CurrentFloor.bBlockingHit || bJustTeleported || bForceNextFloorCheck)
+	{
+		return false;
+	}
+
+	// Floor height adjustments move the capsule slightly up or down after the sweep
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector& SweepStart = CurrentFloor.HitResult.TraceStart;
+	return FVector::DistSquared2D(Location, SweepStart) <= FMath::Square(KINDA_SMALL_NUMBER) && FMath::Abs(Location.Z - SweepStart.Z) <= MAX_FLOOR_DIST;
 }
 
 void UExhibitionMovementComponent::PhysSlide(float deltaTime, int32 Iterations)
 {
+	EXHIBITION_MOVEMENT_SCOPE(PhysSlide);
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -657,17 +969,19 @@ void UExhibitionMovementComponent::PhysSlide(float deltaTime, int32 Iterations)
 
 #pragma region Roll
 
-void UExhibitionMovementComponent::PerformDive()
+EExhibitionDiveType UExhibitionMovementComponent::PerformDive()
 {
 	ensure(CharacterOwner != nullptr);
 	
 	FVector RollDirection = (Acceleration.IsNearlyZero()? CharacterOwner->GetActorForwardVector() : Acceleration).GetSafeNormal2D();
 	UAnimMontage* NextMontage;
 	float ApplyingImpulse;
+	EExhibitionDiveType DiveType;
 	
 	if (Velocity.SizeSquared2D() > FMath::Pow(DiveMinSpeed, 2) && !IsFalling())
 	{
 		NextMontage = DiveMontage;
+		DiveType = EExhibitionDiveType::Dive;
 		bWantsToCrouch = true;
 
 		ApplyingImpulse = DiveImpulse;
@@ -677,6 +991,7 @@ void UExhibitionMovementComponent::PerformDive()
 	else if (IsFalling())
 	{
 		NextMontage = FlyingDiveMontage;
+		DiveType = EExhibitionDiveType::FlyingDive;
 		ApplyingImpulse = FlyingDiveImpulse;
 		Safe_FlyingDiveCount++;
 
@@ -686,6 +1001,7 @@ void UExhibitionMovementComponent::PerformDive()
 	{
 		RollDirection = -RollDirection;
 		NextMontage = DodgeBackMontage;
+		DiveType = EExhibitionDiveType::DodgeBack;
 		bOrientRotationToMovement = false;
 
 		ApplyingImpulse = DodgeBackImpulse;
@@ -695,6 +1011,8 @@ void UExhibitionMovementComponent::PerformDive()
 	const float OldZVelocity = Velocity.Z;
 	Velocity = RollDirection * ApplyingImpulse;
 	Velocity.Z = OldZVelocity;
+
+	return DiveType;
 }
 
 bool UExhibitionMovementComponent::CanDive() const
@@ -708,181 +1026,516 @@ bool UExhibitionMovementComponent::CanDive() const
 
 bool UExhibitionMovementComponent::TryHook()
 {
+	EXHIBITION_MOVEMENT_SCOPE(TryHook);
+
 	if (!IsFalling() && !IsWalking())
 	{
 		return false;
 	}
 	
-	TArray<AActor*> AllHooks;
-	// Can be improved
-	UGameplayStatics::GetAllActorsWithTag(GetWorld(), TagHookName, AllHooks);
+	const UExhibitionHookSubsystem* HookSubsystem = GetWorld()->GetSubsystem<UExhibitionHookSubsystem>();
+	if (HookSubsystem == nullptr)
+	{
+		return false;
+	}
 
-	if (AllHooks.IsEmpty())
+	ScoreHookCandidates(*HookSubsystem, 0);
+	if (HookShortlist.IsEmpty())
 	{
 		return false;
 	}
 
-	AActor* SelectedHook = nullptr;
-	float SelectedHookDistanceSrd = FMath::Pow(MaxHookDistance, 2);
-	float SelectedDotResult = 0.f;
-	for (AActor* Hook : AllHooks)
+	// Candidates come best ranked first: the first visible one wins, only the hooks ranked above it pay for a sweep.
+	// When a whole page is blocked the next ranked hooks get their turn.
+	for (int32 FirstCandidate = 0; !HookShortlist.IsEmpty(); FirstCandidate += HookShortlistSize)
 	{
-		float HookDistance = 0.f, DotResult = 0.f;
-		bool bIsBlocked = false;
-		
-		if (CanUseHook(Hook, HookDistance, DotResult, bIsBlocked) &&
-			HookDistance <= SelectedHookDistanceSrd &&
-			DotResult >= SelectedDotResult
-		)
+		for (const FExhibitionHookScore& Candidate : HookShortlist)
 		{
-			SelectedHook = Hook;
-			SelectedHookDistanceSrd = HookDistance;
-			SelectedDotResult = DotResult;
+			if (!IsHookBlocked(Candidate.Hook))
+			{
+				return CommitHook(Candidate.Hook);
+			}
+		}
+
+		if (HookShortlist.Num() < HookShortlistSize)
+		{
+			break;
 		}
+
+		ScoreHookCandidates(*HookSubsystem, FirstCandidate + HookShortlistSize);
 	}
 
-	CurrentHook = SelectedHook;
-	const FVector Destination = (SelectedHook != nullptr)? SelectedHook->GetActorLocation() : FVector::ZeroVector;
-	PrepareTravel(HOOK_TRAVEL_NAME, Destination, ReleaseHookTolerance, FVector::ZeroVector, MaxHookSpeed, HookCurve);
-	return SelectedHook != nullptr;
+	return CommitHook(nullptr);
 }
 
-bool UExhibitionMovementComponent::CanUseHook(const AActor* Hook, float& DistSqr, float& DotResult, bool& bIsBlocked) const
+bool UExhibitionMovementComponent::TrySearchHook()
 {
-	if (!Hook)
+	// Async results land on a later frame, which differs between machines: only the live owner waits for them.
+	// Replays and the server commit in the move that carries the pick, a move without one keeps waiting.
+	if (bAsyncHookResolution)
 	{
-		return false;
+		const bool bLiveOwner = CharacterOwner->IsLocallyControlled() && !CharacterOwner->bClientUpdating;
+		return bLiveOwner && TryHookAsync();
 	}
 
-	const FVector CharacterLocation = UpdatedComponent->GetComponentLocation();
-	const FRotator CharacterViewRotation = UpdatedComponent->GetComponentRotation();
-	
-	const FVector ControlLook = CharacterViewRotation.Vector().GetSafeNormal2D();
-	const FVector HookLocation = Hook->GetActorLocation();
-	const FVector ControlLookToHook = (HookLocation - CharacterLocation).GetSafeNormal2D();
+	return TryHook();
+}
 
-	if (CVarDebugMovement->GetBool())
+bool UExhibitionMovementComponent::TryClientHook()
+{
+	AActor* ClientHook = Safe_ClientTarget.Get();
+	if (ClientHook == nullptr)
 	{
-		LINE(CharacterLocation, CharacterLocation + ControlLook * 500.f, FColor::Red);
-		LINE(CharacterLocation, CharacterLocation + ControlLookToHook * 500.f, FColor::Green);
+		return false;
 	}
 
-	DistSqr = FVector::DistSquared(CharacterLocation, HookLocation);
-	const bool bNear = DistSqr <= FMath::Pow(MaxHookDistance, 2);
-
-	if (!bNear)
+	if ((!IsFalling() && !IsWalking()) || !ClientHook->ActorHasTag(TagHookName))
 	{
 		return false;
 	}
 
-	DotResult = ControlLook | ControlLookToHook;
-	const bool bInFov = DotResult >= 0.8f;
-	if (!bInFov)
+	// Same rules as a full search, for a single candidate. A rejection falls back to the full search.
+	float DistSqr = 0.f;
+	float DotResult = 0.f;
+	bool bIsBlocked = false;
+	if (!CanUseHook(ClientHook, DistSqr, DotResult, bIsBlocked))
 	{
 		return false;
 	}
 
-	FCollisionShape Capsule = FCollisionShape::MakeCapsule(GetCapsuleRadius(), GetCapsuleHalfHeight());
-	FHitResult Hit;
-	FCollisionQueryParams IgnoreParams = ExhibitionCharacterRef->GetIgnoreCollisionParams();
-	IgnoreParams.AddIgnoredActor(Hook);
-	bIsBlocked = GetWorld()->SweepSingleByProfile(
-		Hit,
-		CharacterLocation,
-		HookLocation,
-		FRotator::ZeroRotator.Quaternion(),
-		FName(TEXT("BlockAll")),
-		Capsule,
-		IgnoreParams
-	);
-
-	if (bIsBlocked && CVarDebugMovement->GetBool())
-	{
-		CAPSULE(Hit.Location, Capsule.GetCapsuleHalfHeight(), Capsule.GetCapsuleRadius(), FColor::Red);
-	}
-	
-	return !bIsBlocked;
+	return CommitHook(ClientHook);
 }
 
-void UExhibitionMovementComponent::EnterHook()
+bool UExhibitionMovementComponent::TryHookAsync()
 {
-	bOrientRotationToMovement = false;
+	EXHIBITION_MOVEMENT_SCOPE(TryHookAsync);
 
-	ApplyTravel();
-	
-	if (bHandleCable)
+	if (!IsFalling() && !IsWalking())
 	{
-		ToggleHookCable();
+		ResetPendingHookSearch();
+		return false;
 	}
 
-	OnEnterHook.Broadcast();
-}
-
-void UExhibitionMovementComponent::FinishHook()
-{
-	Safe_bWantsToHook = false;
-	bOrientRotationToMovement = true;
-	TravelData->Reset();
-	CurrentHook = nullptr;
-	RemoveRootMotionSource(FName(HOOK_TRAVEL_NAME));
-	
-	if (bHandleCable)
+	UWorld* World = GetWorld();
+	int32 FirstCandidate = 0;
+	if (PendingHookSearch.IsPending())
 	{
-		ResetHookCable();
-	}
+		// Async trace results are only readable during the frame after they were issued
+		if (PendingHookSearch.IssuedFrame == GFrameCounter)
+		{
+			return false;
+		}
+
+		bool bExpired = false;
+		AActor* SelectedHook = ResolvePendingHookSearch(bExpired);
+		const bool bLastPage = PendingHookSearch.Hooks.Num() < HookShortlistSize;
+		const int32 PendingFirstCandidate = PendingHookSearch.FirstCandidate;
+		ResetPendingHookSearch();
+		if (!bExpired)
+		{
+			if (SelectedHook != nullptr || bLastPage)
+			{
+				return CommitHook(SelectedHook);
+			}
+
+			// Every hook of the page was blocked, trace the next ranked ones
+			FirstCandidate = PendingFirstCandidate + HookShortlistSize;
+		}
+	}
+
+	const UExhibitionHookSubsystem* HookSubsystem = World->GetSubsystem<UExhibitionHookSubsystem>();
+	if (HookSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const FVector CharacterLocation = UpdatedComponent->GetComponentLocation();
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(GetCapsuleRadius(), GetCapsuleHalfHeight());
+	for (;; FirstCandidate += HookShortlistSize)
+	{
+		ScoreHookCandidates(*HookSubsystem, FirstCandidate);
+
+		int32 NumIssued = 0;
+		for (const FExhibitionHookScore& Candidate : HookShortlist)
+		{
+			bool bIsBlocked = false;
+			FTraceHandle Handle;
+			if (!FindCachedHookVisibility(Candidate.Hook, bIsBlocked))
+			{
+				Handle = World->AsyncSweepByProfile(
+					EAsyncTraceType::Single,
+					CharacterLocation,
+					Candidate.Hook->GetActorLocation(),
+					FRotator::ZeroRotator.Quaternion(),
+					FName(TEXT("BlockAll")),
+					Capsule,
+					GetHookQueryParams(Candidate.Hook)
+				);
+				++NumIssued;
+			}
+
+			PendingHookSearch.Hooks.Add(Candidate.Hook);
+			PendingHookSearch.bIsBlocked.Add(bIsBlocked);
+			PendingHookSearch.Handles.Add(Handle);
+		}
+
+		EXHIBITION_MOVEMENT_COUNT(Traces, NumIssued);
+
+		if (NumIssued > 0)
+		{
+			PendingHookSearch.IssuedFrame = GFrameCounter;
+			PendingHookSearch.FirstCandidate = FirstCandidate;
+			return false;
+		}
+
+		// Every candidate of the page was already known, no need to wait a frame
+		bool bExpired = false;
+		AActor* SelectedHook = ResolvePendingHookSearch(bExpired);
+		ResetPendingHookSearch();
+		if (SelectedHook != nullptr || HookShortlist.Num() < HookShortlistSize)
+		{
+			return CommitHook(SelectedHook);
+		}
+	}
+}
+
+AActor* UExhibitionMovementComponent::ResolvePendingHookSearch(bool& bExpired)
+{
+	AActor* SelectedHook = nullptr;
+	bExpired = false;
+
+	// Every result is read so the visibility cache gets all of them, the page is ranked so the first visible hook wins
+	for (int32 Index = 0; Index < PendingHookSearch.Hooks.Num(); ++Index)
+	{
+		AActor* Hook = PendingHookSearch.Hooks[Index].Get();
+		bool bIsBlocked = PendingHookSearch.bIsBlocked[Index];
+
+		const FTraceHandle& Handle = PendingHookSearch.Handles[Index];
+		if (Handle.IsValid())
+		{
+			FTraceDatum TraceDatum;
+			if (!GetWorld()->QueryTraceData(Handle, TraceDatum))
+			{
+				bExpired = true;
+				return nullptr;
+			}
+
+			bIsBlocked = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+			if (Hook != nullptr)
+			{
+				CacheHookVisibility(Hook, TraceDatum.Start, bIsBlocked);
+			}
+		}
+
+		if (SelectedHook == nullptr && Hook != nullptr && !bIsBlocked)
+		{
+			SelectedHook = Hook;
+		}
+	}
+
+	return SelectedHook;
+}
+
+void UExhibitionMovementComponent::ScoreHookCandidates(const UExhibitionHookSubsystem& HookSubsystem, const int32 FirstCandidate)
+{
+	HookSubsystem.ScoreHooks(
+		TagHookName,
+		UpdatedComponent->GetComponentLocation(),
+		UpdatedComponent->GetComponentRotation().Vector(),
+		FCollisionShape::MakeCapsule(GetCapsuleRadius(), GetCapsuleHalfHeight()),
+		MaxHookDistance,
+		HookFieldOfViewDot,
+		FirstCandidate,
+		HookShortlistSize,
+		HookShortlist
+	);
+}
+
+void UExhibitionMovementComponent::ResetPendingHookSearch()
+{
+	PendingHookSearch.Hooks.Reset();
+	PendingHookSearch.bIsBlocked.Reset();
+	PendingHookSearch.Handles.Reset();
+}
+
+bool UExhibitionMovementComponent::CommitHook(AActor* SelectedHook)
+{
+	CurrentHook = SelectedHook;
+	const FVector Destination = (SelectedHook != nullptr)? SelectedHook->GetActorLocation() : FVector::ZeroVector;
+	PrepareTravel(HOOK_TRAVEL_NAME, Destination, ReleaseHookTolerance, FVector::ZeroVector, MaxHookSpeed, HookCurve);
+	return SelectedHook != nullptr;
+}
+
+bool UExhibitionMovementComponent::CanUseHook(const AActor* Hook, float& DistSqr, float& DotResult, bool& bIsBlocked) const
+{
+	EXHIBITION_MOVEMENT_SCOPE(CanUseHook);
+
+	if (!IsHookInRange(Hook, DistSqr, DotResult))
+	{
+		return false;
+	}
+
+	bIsBlocked = IsHookBlocked(Hook);
+	return !bIsBlocked;
+}
+
+bool UExhibitionMovementComponent::IsHookInRange(const AActor* Hook, float& DistSqr, float& DotResult) const
+{
+	if (!Hook)
+	{
+		return false;
+	}
+
+	const FVector CharacterLocation = UpdatedComponent->GetComponentLocation();
+	const FRotator CharacterViewRotation = UpdatedComponent->GetComponentRotation();
+	
+	const FVector ControlLook = CharacterViewRotation.Vector().GetSafeNormal2D();
+	const FVector HookLocation = Hook->GetActorLocation();
+	const FVector ControlLookToHook = (HookLocation - CharacterLocation).GetSafeNormal2D();
+
+	if (CVarDebugMovement->GetBool())
+	{
+		LINE(CharacterLocation, CharacterLocation + ControlLook * 500.f, FColor::Red);
+		LINE(CharacterLocation, CharacterLocation + ControlLookToHook * 500.f, FColor::Green);
+	}
+
+	DistSqr = FVector::DistSquared(CharacterLocation, HookLocation);
+	const bool bNear = DistSqr <= FMath::Pow(MaxHookDistance, 2);
+
+	if (!bNear)
+	{
+		return false;
+	}
+
+	DotResult = ControlLook | ControlLookToHook;
+	const bool bInFov = DotResult >= HookFieldOfViewDot;
+	return bInFov;
+}
+
+bool UExhibitionMovementComponent::IsHookBlocked(const AActor* Hook) const
+{
+	EXHIBITION_MOVEMENT_SCOPE(IsHookBlocked);
+
+	bool bCachedBlocked = false;
+	if (FindCachedHookVisibility(Hook, bCachedBlocked))
+	{
+		return bCachedBlocked;
+	}
+
+	EXHIBITION_MOVEMENT_COUNT(Traces, 1);
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(GetCapsuleRadius(), GetCapsuleHalfHeight());
+	FHitResult Hit;
+	const bool bIsBlocked = GetWorld()->SweepSingleByProfile(
+		Hit,
+		UpdatedComponent->GetComponentLocation(),
+		Hook->GetActorLocation(),
+		FRotator::ZeroRotator.Quaternion(),
+		FName(TEXT("BlockAll")),
+		Capsule,
+		GetHookQueryParams(Hook)
+	);
+
+	if (bIsBlocked && CVarDebugMovement->GetBool())
+	{
+		CAPSULE(Hit.Location, Capsule.GetCapsuleHalfHeight(), Capsule.GetCapsuleRadius(), FColor::Red);
+	}
+
+	CacheHookVisibility(Hook, UpdatedComponent->GetComponentLocation(), bIsBlocked);
+	return bIsBlocked;
+}
+
+bool UExhibitionMovementComponent::FindCachedHookVisibility(const AActor* Hook, bool& bIsBlocked) const
+{
+	if (HookVisibilityCacheDistance <= 0.f)
+	{
+		return false;
+	}
+
+	const FHookVisibility* Cached = HookVisibilityCache.Find(Hook);
+	if (Cached == nullptr)
+	{
+		return false;
+	}
+
+	const bool bCharacterMoved = FVector::DistSquared(Cached->CharacterLocation, UpdatedComponent->GetComponentLocation()) > FMath::Square(HookVisibilityCacheDistance);
+	const bool bHookMoved = !Cached->HookLocation.Equals(Hook->GetActorLocation());
+	if (bCharacterMoved || bHookMoved || Cached->CollisionSignature != GetHookCollisionSignature(Hook))
+	{
+		return false;
+	}
+
+	bIsBlocked = Cached->bIsBlocked;
+	return true;
+}
+
+void UExhibitionMovementComponent::CacheHookVisibility(const AActor* Hook, const FVector& CharacterLocation, const bool bIsBlocked) const
+{
+	if (HookVisibilityCacheDistance <= 0.f)
+	{
+		return;
+	}
+
+	// Entries are refreshed in place, drop the ones left behind by hooks that are gone
+	if (HookVisibilityCache.Num() > HookShortlistSize * 8)
+	{
+		for (auto It = HookVisibilityCache.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	FHookVisibility& Cached = HookVisibilityCache.FindOrAdd(Hook);
+	Cached.CharacterLocation = CharacterLocation;
+	Cached.HookLocation = Hook->GetActorLocation();
+	Cached.CollisionSignature = GetHookCollisionSignature(Hook);
+	Cached.bIsBlocked = bIsBlocked;
+}
+
+uint32 UExhibitionMovementComponent::GetHookCollisionSignature(const AActor* Hook)
+{
+	const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Hook->GetRootComponent());
+	if (Primitive == nullptr)
+	{
+		return 0;
+	}
+
+	uint32 Signature = GetTypeHash(Primitive->GetCollisionProfileName());
+	Signature = HashCombine(Signature, GetTypeHash(static_cast<uint8>(Primitive->GetCollisionEnabled())));
+	Signature = HashCombine(Signature, GetTypeHash(static_cast<uint8>(Primitive->GetCollisionObjectType())));
+	return Signature;
+}
+
+FCollisionQueryParams UExhibitionMovementComponent::GetHookQueryParams(const AActor* Hook) const
+{
+	FCollisionQueryParams IgnoreParams = ExhibitionCharacterRef->GetIgnoreCollisionParams();
+	IgnoreParams.AddIgnoredActor(Hook);
+	return IgnoreParams;
+}
+
+void UExhibitionMovementComponent::EnterHook()
+{
+	bOrientRotationToMovement = false;
+
+	ApplyTravel();
+	
+	if (bHandleCable)
+	{
+		ToggleHookCable();
+	}
+
+	OnEnterHook.Broadcast();
+}
+
+void UExhibitionMovementComponent::FinishHook()
+{
+	Safe_bWantsToHook = false;
+	bOrientRotationToMovement = true;
+	TravelData->Reset();
+	CurrentHook = nullptr;
+	RemoveRootMotionSource(FName(HOOK_TRAVEL_NAME));
+	
+	if (bHandleCable)
+	{
+		ResetHookCable();
+	}
 
 	OnExitHook.Broadcast();
 }
 
-void UExhibitionMovementComponent::ToggleHookCable()
+void UExhibitionMovementComponent::BindHookCable()
 {
 	ensure(CharacterOwner != nullptr);
 
-	UCableComponent* HookCable = CharacterOwner->FindComponentByClass<UCableComponent>();
+	HookLine = CharacterOwner->FindComponentByClass<UExhibitionHookLineComponent>();
+	HookCable = CharacterOwner->FindComponentByClass<UCableComponent>();
+	if (HookLine == nullptr || HookCable == nullptr)
+	{
+		return;
+	}
+
+	// Blueprints made before the hook line still carry a cable, keep it from simulating for nothing
+	HookCable->SetComponentTickEnabled(false);
+	HookCable->SetHiddenInGame(true);
+	HookCable = nullptr;
+}
+
+void UExhibitionMovementComponent::ToggleHookCable()
+{
+	CurrentCableTime = 0.f;
+
+	if (HookLine != nullptr)
+	{
+		if (HookLine->bHiddenInGame)
+		{
+			HookLine->ShowLine();
+		}
+		else
+		{
+			HookLine->HideLine();
+		}
+		return;
+	}
+
 	if (HookCable)
 	{
 		HookCable->bAttachEnd = true;
 		HookCable->bAttachStart = true;
 		HookCable->SetHiddenInGame(!HookCable->bHiddenInGame);
-		CurrentCableTime = 0.f;
 	}
 }
 
 void UExhibitionMovementComponent::UpdateHookCable(const float DeltaTime)
 {
+	EXHIBITION_MOVEMENT_SCOPE(UpdateHookCable);
+
 	ensure(CharacterOwner != nullptr);
 
-	UCableComponent* HookCable = CharacterOwner->FindComponentByClass<UCableComponent>();
 	const FVector TravelDestinationLocation = TravelData->Destination;
+	if ((HookLine == nullptr && HookCable == nullptr) || TravelDestinationLocation == FVector::ZeroVector)
+	{
+		return;
+	}
+
+	const FVector HandLocation = (!HookSocketName.IsNone())? CharacterOwner->GetMesh()->GetSocketLocation(HookSocketName) : UpdatedComponent->GetComponentLocation();
+	const FVector TargetToHand = (TravelDestinationLocation - HandLocation).GetSafeNormal();
+
+	// The cable is placed at its hook end, the line always spans from the hand
+	const FVector LengthOrigin = (HookLine != nullptr)? HandLocation : HookCable->GetComponentLocation();
+	const float MaxLength = FVector::Dist(LengthOrigin, TravelDestinationLocation);
+	float CurrentLength = MaxLength;
 	
-	if (HookCable && TravelDestinationLocation != FVector::ZeroVector)
+	CurrentCableTime = FMath::Clamp(CurrentCableTime + DeltaTime, 0.f, CableTimeToReachDestination);
+	FVector EndLocation = TravelDestinationLocation;
+	if (CurrentCableTime < CableTimeToReachDestination)
 	{
-		const FVector HandLocation = (!HookSocketName.IsNone())? CharacterOwner->GetMesh()->GetSocketLocation(HookSocketName) : UpdatedComponent->GetComponentLocation();
-		const FVector TargetToHand = (TravelDestinationLocation - HandLocation).GetSafeNormal();
-		
-		const float MaxLength = FVector::Dist(HookCable->GetComponentLocation(), TravelDestinationLocation);
-		float CurrentLength = MaxLength;
-		
-		CurrentCableTime = FMath::Clamp(CurrentCableTime + DeltaTime, 0.f, CableTimeToReachDestination);
-		FVector EndLocation = TravelDestinationLocation;
-		if (CurrentCableTime < CableTimeToReachDestination)
-		{
-			const float TimeRatio = FMath::Clamp(CableCurve.GetRichCurveConst()->Eval(CurrentCableTime / CableTimeToReachDestination), 0.f, 1.f);
-			CurrentLength = FMath::Lerp(0.f, MaxLength, TimeRatio);
-			EndLocation = HandLocation + (TargetToHand * CurrentLength);
-		}
+		const float TimeRatio = FMath::Clamp(BakedCableCurve.Eval(CurrentCableTime / CableTimeToReachDestination), 0.f, 1.f);
+		CurrentLength = FMath::Lerp(0.f, MaxLength, TimeRatio);
+		EndLocation = HandLocation + (TargetToHand * CurrentLength);
+	}
 
-		HookCable->SetUsingAbsoluteLocation(true);
-		HookCable->SetWorldLocation(EndLocation);
-		HookCable->CableLength = CurrentLength;
+	if (HookLine != nullptr)
+	{
+		HookLine->UpdateLine(HandLocation, EndLocation);
+		return;
 	}
+
+	HookCable->SetUsingAbsoluteLocation(true);
+	HookCable->SetWorldLocation(EndLocation);
+	HookCable->CableLength = CurrentLength;
 }
 
 void UExhibitionMovementComponent::ResetHookCable()
 {
-	ensure(CharacterOwner != nullptr);
+	if (HookLine != nullptr)
+	{
+		HookLine->HideLine();
+		CurrentCableTime = 0.f;
+		return;
+	}
 
-	UCableComponent* HookCable = CharacterOwner->FindComponentByClass<UCableComponent>();
 	if (HookCable)
 	{
 		ToggleHookCable();
@@ -896,8 +1549,121 @@ void UExhibitionMovementComponent::ResetHookCable()
 
 #pragma region Rope
 
+namespace ExhibitionRopeArc
+{
+	// Same horizon PredictProjectilePath uses by default
+	constexpr float MaxSimTime = 2.f;
+
+	// Straight sweeps a hit is confirmed with, along the arc
+	constexpr int32 ConfirmSegments = 4;
+
+	struct FHit
+	{
+		float Time = 0.f;
+		FVector Location = FVector::ZeroVector;
+		int32 Candidate = INDEX_NONE;
+	};
+
+	static FVector Evaluate(const FVector& Start, const FVector& Velocity, const float GravityZ, const float Time)
+	{
+		return Start + Velocity * Time + FVector(0.f, 0.f, 0.5f * GravityZ * Time * Time);
+	}
+
+	// Sweeps the arc piecewise up to EndTime, a single chord would cut through what the arc clears and the other way around
+	static bool IsClear(const UWorld& World, const FVector& Start, const FVector& Velocity, const float GravityZ, const float EndTime, const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams)
+	{
+		FVector Previous = Start;
+		for (int32 Segment = 1; Segment <= ConfirmSegments; ++Segment)
+		{
+			const FVector Next = Evaluate(Start, Velocity, GravityZ, EndTime * Segment / ConfirmSegments);
+			EXHIBITION_MOVEMENT_COUNT(Traces, 1);
+			if (World.SweepTestByChannel(Previous, Next, FQuat::Identity, ECC_WorldStatic, Shape, QueryParams))
+			{
+				return false;
+			}
+			Previous = Next;
+		}
+
+		return true;
+	}
+
+	// Closed form jump parabola vs rope segment test.
+	// The arc moves linearly on the horizontal plane, so it crosses the segment at most once: solve that crossing,
+	// then check the heights match within Radius. Straight up jumps solve the height quadratic instead.
+	static bool Intersect(const FVector& Start, const FVector& Velocity, const float GravityZ, const float Radius, const FVector& RopeStart, const FVector& RopeEnd, float& OutTime, FVector& OutLocation)
+	{
+		const FVector2D Velocity2D(Velocity);
+		const FVector2D RopeDirection2D(RopeEnd - RopeStart);
+		const FVector2D StartToRope(RopeStart - Start);
+
+		float Time = -1.f;
+		float RopeAlpha = 0.f;
+		if (Velocity2D.SizeSquared() > UE_KINDA_SMALL_NUMBER)
+		{
+			const float Denominator = FVector2D::CrossProduct(Velocity2D, RopeDirection2D);
+			if (FMath::IsNearlyZero(Denominator))
+			{
+				// Running along the rope, the sweep would graze it at best
+				return false;
+			}
+
+			Time = FVector2D::CrossProduct(StartToRope, RopeDirection2D) / Denominator;
+			RopeAlpha = FVector2D::CrossProduct(StartToRope, Velocity2D) / Denominator;
+			if (RopeAlpha < 0.f || RopeAlpha > 1.f)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const FVector ClosestOnRope = FMath::ClosestPointOnSegment(FVector(Start.X, Start.Y, 0.f), FVector(RopeStart.X, RopeStart.Y, 0.f), FVector(RopeEnd.X, RopeEnd.Y, 0.f));
+			if (FVector::DistSquared2D(ClosestOnRope, Start) > FMath::Square(Radius))
+			{
+				return false;
+			}
+
+			const float RopeLength2D = RopeDirection2D.Size();
+			RopeAlpha = (RopeLength2D > UE_KINDA_SMALL_NUMBER)? FVector2D::Distance(FVector2D(ClosestOnRope), FVector2D(RopeStart)) / RopeLength2D : 0.f;
+
+			// 0.5 * g * t^2 + Vz * t + (StartZ - RopeZ) = 0, first root is the way up
+			const float RopeZ = FMath::Lerp(RopeStart.Z, RopeEnd.Z, RopeAlpha);
+			const float A = 0.5f * GravityZ;
+			const float B = Velocity.Z;
+			const float C = Start.Z - RopeZ;
+			const float Discriminant = B * B - 4.f * A * C;
+			if (FMath::IsNearlyZero(A) || Discriminant < 0.f)
+			{
+				return false;
+			}
+
+			const float SqrtDiscriminant = FMath::Sqrt(Discriminant);
+			const float RootA = (-B + SqrtDiscriminant) / (2.f * A);
+			const float RootB = (-B - SqrtDiscriminant) / (2.f * A);
+			Time = (RootA >= 0.f)? FMath::Min(RootA, (RootB >= 0.f)? RootB : RootA) : RootB;
+		}
+
+		if (Time < 0.f || Time > MaxSimTime)
+		{
+			return false;
+		}
+
+		const FVector ArcLocation = Evaluate(Start, Velocity, GravityZ, Time);
+		const FVector RopeLocation = FMath::Lerp(RopeStart, RopeEnd, RopeAlpha);
+		if (FMath::Abs(ArcLocation.Z - RopeLocation.Z) > Radius)
+		{
+			return false;
+		}
+
+		OutTime = Time;
+		OutLocation = ArcLocation;
+		return true;
+	}
+}
+
 bool UExhibitionMovementComponent::TryRope()
 {
+	EXHIBITION_MOVEMENT_SCOPE(TryRope);
+
 	if (!CharacterOwner->CanJump())
 	{
 		return false;
@@ -909,51 +1675,20 @@ bool UExhibitionMovementComponent::TryRope()
 
 	const float Additive = FMath::Clamp(JumpAdditive, 0.f, 100.f);
 	const FVector JumpVelocity = {Velocity.X, Velocity.Y, JumpHeight + (GetCapsuleHalfHeight() * 2) + Additive};
-	FPredictProjectilePathParams JumpSimulatePath;
-	JumpSimulatePath.StartLocation = StartTrace;
-	JumpSimulatePath.LaunchVelocity = JumpVelocity;
-	JumpSimulatePath.ActorsToIgnore = ExhibitionCharacterRef->GetIgnoredActors();
-	JumpSimulatePath.bTraceWithCollision = true;
-	JumpSimulatePath.bTraceWithChannel = true;
-	JumpSimulatePath.TraceChannel = ECC_WorldStatic;
-	JumpSimulatePath.ProjectileRadius = GetCapsuleRadius();
-
-	if (CVarDebugMovement->GetBool())
-	{
-		JumpSimulatePath.DrawDebugType = EDrawDebugTrace::ForDuration;
-		JumpSimulatePath.DrawDebugTime = 5.f;
-	}
 
-	FPredictProjectilePathResult JumpSimulateResult;
-	const bool bFoundSomething = UGameplayStatics::PredictProjectilePath(
-		GetWorld(),
-		JumpSimulatePath,
-		JumpSimulateResult
-	);
-
-	if (!bFoundSomething)
-	{
-		return false;
-	}
-	
-	const FHitResult Hit = JumpSimulateResult.HitResult;
-	if (!Hit.GetActor() || !Hit.GetActor()->ActorHasTag(TagRopeName))
-	{
-		return false;
-	}
-	
-	const AActor* HitActor = Hit.GetActor();
-	UCableComponent* ActualRope = HitActor->FindComponentByClass<UCableComponent>();
-	if (ActualRope == nullptr)
+	FVector HitLocation;
+	FExhibitionRopeSegment HitRope;
+	if (!FindRopeOnJumpArc(StartTrace, JumpVelocity, HitLocation, HitRope))
 	{
 		return false;
 	}
 
-	FVector StartRope, EndRope;
-	GetRopePositions(ActualRope, StartRope, EndRope);
+	const AActor* HitActor = HitRope.Rope;
+	const FVector StartRope = HitRope.Start;
+	const FVector EndRope = HitRope.End;
 	const FVector RopeNormal = (EndRope - StartRope).GetSafeNormal();
 	
-	const FVector HitOnRope = FMath::ClosestPointOnSegment(Hit.Location, StartRope, EndRope);
+	const FVector HitOnRope = FMath::ClosestPointOnSegment(HitLocation, StartRope, EndRope);
 	const float DownFactor = FMath::Clamp(RopeGrabFactor, 0.f, 1.f);
 	const FVector TransitionDestination = HitOnRope + FVector::DownVector * (GetCapsuleHalfHeight() * DownFactor);
 
@@ -976,6 +1711,7 @@ bool UExhibitionMovementComponent::TryRope()
 	QueryParams.TraceTag = FName(TEXT("RopeUnReachable"));
 	QueryParams.AddIgnoredActor(HitActor);
 	FHitResult UnReachable;
+	EXHIBITION_MOVEMENT_COUNT(Traces, 1);
 	const bool bUnReachable = GetWorld()->
 		SweepSingleByProfile(
 			UnReachable,
@@ -997,16 +1733,19 @@ bool UExhibitionMovementComponent::TryRope()
 		return false;
 	}
 
+	CurrentRope = HitRope.Rope;
 	PrepareTravel(ROPE_TRAVEL_NAME, RealDestination, RopeReleaseTolerance, RopeNormal, MaxRopeSpeed, RopeSpeedCurve);
 
 	const float TravelDistance = FVector::Dist(RealDestination, UpdatedComponent->GetComponentLocation());
 	const float JumpToRopeDuration = FMath::Clamp(TravelDistance / 500.f, 0.1, JumpToRopeMaxDuration);
 
 	PlayMontage(HangToRopeMontage);
-	if (IsServer())
-	{
-		Proxy_FindRope = !Proxy_FindRope;
-	}
+
+	FExhibitionMovementEvent RopeEvent;
+	RopeEvent.Type = EExhibitionMovementEvent::Rope;
+	RopeEvent.Location = RealDestination;
+	RopeEvent.Normal = RopeNormal;
+	PushProxyEvent(RopeEvent);
 	SetMovementMode(MOVE_Flying);
 	ApplyTransition(ROPE_TRANSITION_NAME, TransitionDestination, JumpToRopeDuration);
 	return true;
@@ -1016,10 +1755,8 @@ void UExhibitionMovementComponent::EnterRope()
 {
 	bOrientRotationToMovement = false;
 
-	if (GetOwnerRole() != ROLE_SimulatedProxy)
-	{
-		ApplyTravel();
-	}
+	// Simulated proxies got the travel from the rope event and integrate it like everyone else
+	ApplyTravel();
 
 	OnEnterRope.Broadcast();
 }
@@ -1029,33 +1766,83 @@ void UExhibitionMovementComponent::FinishRope()
 	bOrientRotationToMovement = true;
 
 	TravelData->Reset();
+	CurrentRope = nullptr;
 	RemoveRootMotionSource(FName(ROPE_TRAVEL_NAME));
 
 	OnExitRope.Broadcast();
 }
 
-void UExhibitionMovementComponent::GetRopePositions(const UCableComponent* Rope, FVector& StartPosition, FVector& EndPosition)
+bool UExhibitionMovementComponent::FindRopeOnJumpArc(const FVector& Start, const FVector& LaunchVelocity, FVector& OutLocation, FExhibitionRopeSegment& OutRope)
 {
-	if (Rope == nullptr)
+	const UExhibitionRopeSubsystem* RopeSubsystem = GetWorld()->GetSubsystem<UExhibitionRopeSubsystem>();
+	if (RopeSubsystem == nullptr)
 	{
-		return;
+		return false;
+	}
+
+	const float GravityZ = GetWorld()->GetGravityZ();
+	const float Radius = GetCapsuleRadius();
+	const float MaxTime = ExhibitionRopeArc::MaxSimTime;
+
+	// Bounds of the whole arc: both ends plus the apex when it is reached in time
+	FBox ArcBounds(Start, Start);
+	ArcBounds += ExhibitionRopeArc::Evaluate(Start, LaunchVelocity, GravityZ, MaxTime);
+	if (GravityZ < 0.f && LaunchVelocity.Z > 0.f)
+	{
+		ArcBounds += ExhibitionRopeArc::Evaluate(Start, LaunchVelocity, GravityZ, FMath::Min(-LaunchVelocity.Z / GravityZ, MaxTime));
 	}
+	ArcBounds = ArcBounds.ExpandBy(Radius);
+
+	RopeSubsystem->QueryRopes(TagRopeName, ArcBounds, RopeCandidates);
+	EXHIBITION_MOVEMENT_COUNT(RopeCandidates, RopeCandidates.Num());
 
-	StartPosition = Rope->GetComponentLocation();
-	const USceneComponent* EndComponent = Cast<USceneComponent>(Rope->AttachEndTo.GetComponent(Rope->GetOwner()));
-	if(EndComponent == nullptr)
+	TArray<ExhibitionRopeArc::FHit, TInlineAllocator<8>> Hits;
+	for (int32 Candidate = 0; Candidate < RopeCandidates.Num(); ++Candidate)
 	{
-		EndComponent = Rope;
+		const FExhibitionRopeSegment& Rope = RopeCandidates[Candidate];
+		ExhibitionRopeArc::FHit& Hit = Hits.AddDefaulted_GetRef();
+		Hit.Candidate = Candidate;
+		if (!ExhibitionRopeArc::Intersect(Start, LaunchVelocity, GravityZ, Radius, Rope.Start, Rope.End, Hit.Time, Hit.Location))
+		{
+			Hits.Pop(false);
+		}
 	}
 
-	if (Rope->AttachEndToSocketName != NAME_None)
+	Hits.Sort([](const ExhibitionRopeArc::FHit& A, const ExhibitionRopeArc::FHit& B) { return A.Time < B.Time; });
+
+	// Earliest hit first, nothing static may stand on the arc between the jump and the rope
+	const FCollisionQueryParams IgnoreParams = ExhibitionCharacterRef->GetIgnoreCollisionParams();
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(Radius);
+	float BestTime = MaxTime;
+	bool bFound = false;
+	for (const ExhibitionRopeArc::FHit& Hit : Hits)
 	{
-		EndPosition = EndComponent->GetSocketTransform(Rope->AttachEndToSocketName).TransformPosition(Rope->EndLocation);
+		const FExhibitionRopeSegment& Rope = RopeCandidates[Hit.Candidate];
+		FCollisionQueryParams QueryParams = IgnoreParams;
+		QueryParams.AddIgnoredActor(Rope.Rope);
+		if (ExhibitionRopeArc::IsClear(*GetWorld(), Start, LaunchVelocity, GravityZ, Hit.Time, Sphere, QueryParams))
+		{
+			BestTime = Hit.Time;
+			OutLocation = Hit.Location;
+			OutRope = Rope;
+			bFound = true;
+			break;
+		}
 	}
-	else
+
+	if (CVarDebugMovement->GetBool())
 	{
-		EndPosition = EndComponent->GetComponentTransform().TransformPosition(Rope->EndLocation);
+		const float DebugEnd = bFound? BestTime : MaxTime;
+		FVector Previous = Start;
+		for (int32 Step = 1; Step <= 20; ++Step)
+		{
+			const FVector Next = ExhibitionRopeArc::Evaluate(Start, LaunchVelocity, GravityZ, DebugEnd * Step / 20.f);
+			LINE(Previous, Next, bFound? FColor::Green : FColor::Red);
+			Previous = Next;
+		}
 	}
+
+	return bFound;
 }
 
 #pragma endregion 
@@ -1134,7 +1921,8 @@ void UExhibitionMovementComponent::PrepareTravel(const FString& TravelName, cons
 
 uint16 UExhibitionMovementComponent::ApplyTravel()
 {
-	if (!TravelData.IsSet())
+	// Simulated proxies can enter the mode before the event carrying the destination arrives
+	if (!TravelData.IsSet() || TravelData->TravelName.IsNone())
 	{
 		return (uint16)ERootMotionSourceID::Invalid;
 	}
@@ -1203,6 +1991,8 @@ void UExhibitionMovementComponent::HandleEndTransition(const FRootMotionSource&
 
 void UExhibitionMovementComponent::PhysTravel(float deltaTime, int32 Iterations)
 {
+	EXHIBITION_MOVEMENT_SCOPE(PhysTravel);
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -1345,6 +2135,78 @@ bool UExhibitionMovementComponent::IsOnRope() const
 	return IsCustomMovementMode(CMOVE_Rope);
 }
 
+bool UExhibitionMovementComponent::IsInSteadyTravel() const
+{
+	if (!IsHooking() && !IsOnRope())
+	{
+		return false;
+	}
+
+	if (!TravelData.IsSet() || TravelData->TravelName.IsNone() || Safe_bReachedDestination)
+	{
+		return false;
+	}
+
+	// Transitions, launches and anim root motion still go one move at a time
+	if (GetRootMotionSourceByID(CurrentTransitionId).IsValid() || !PendingLaunchVelocity.IsZero())
+	{
+		return false;
+	}
+
+	return CharacterOwner != nullptr && CharacterOwner->GetRootMotionAnimMontageInstance() == nullptr;
+}
+
+void UExhibitionMovementComponent::BroadcastLocomotionChanges()
+{
+	// Replayed moves end where the last one did, only the final state is worth raising
+	if (CharacterOwner == nullptr || CharacterOwner->bClientUpdating)
+	{
+		return;
+	}
+
+	const bool bCrouching = IsCrouching();
+	if (bCrouching != bBroadcastCrouching)
+	{
+		bBroadcastCrouching = bCrouching;
+		if (bCrouching)
+		{
+			OnStartCrouch.Broadcast();
+		}
+		else
+		{
+			OnEndCrouch.Broadcast();
+		}
+	}
+
+	const bool bSprinting = IsSprinting();
+	if (bSprinting != bBroadcastSprinting)
+	{
+		bBroadcastSprinting = bSprinting;
+		if (bSprinting)
+		{
+			OnStartSprint.Broadcast();
+		}
+		else
+		{
+			OnStopSprint.Broadcast();
+		}
+	}
+
+	const bool bWalking = IsWalking() && !Velocity.IsZero();
+	if (bWalking != bBroadcastWalking)
+	{
+		bBroadcastWalking = bWalking;
+		if (bWalking)
+		{
+			OnStartWalk.Broadcast();
+		}
+		else
+		{
+			OnStopWalk.Broadcast();
+		}
+	}
+}
+
 bool UExhibitionMovementComponent::IsServer() const
 {
 	return CharacterOwner->HasAuthority();
@@ -1354,42 +2216,146 @@ void UExhibitionMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimePr
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION(UExhibitionMovementComponent, Proxy_Dive, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(UExhibitionMovementComponent, Proxy_JumpExtra, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(UExhibitionMovementComponent, Proxy_FindHook, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(UExhibitionMovementComponent, Proxy_FindRope, COND_SkipOwner);
+	// Only compared when an event was pushed
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+	PushParams.Condition = COND_SkipOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UExhibitionMovementComponent, Proxy_Events, PushParams);
 }
 
-void UExhibitionMovementComponent::OnRep_Dive()
+void UExhibitionMovementComponent::OnRep_Events()
 {
-	if (bWantsToCrouch)
+	// Initial replication of a proxy that just became relevant: old montages are not worth playing,
+	// an ongoing hook still needs its destination
+	if (!HasBegunPlay())
 	{
-		// If player wants to crouch he requested a dive
-		CharacterOwner->PlayAnimMontage(DiveMontage);
-		OnDive.Broadcast();
+		LastReplayedEventSequence = Proxy_Events.GetSequence();
+
+		const FExhibitionMovementEvent* Latest = Proxy_Events.GetLatest();
+		if (Latest != nullptr && Latest->Type == EExhibitionMovementEvent::Hook && IsHooking())
+		{
+			ApplyHookTarget(Latest->Target.Get(), Latest->Location);
+		}
+		else if (Latest != nullptr && Latest->Type == EExhibitionMovementEvent::Rope && IsOnRope())
+		{
+			ApplyRopeTarget(Latest->Location, Latest->Normal);
+		}
+		return;
 	}
-	else if (IsFalling())
+
+	TArray<const FExhibitionMovementEvent*, TInlineAllocator<FExhibitionMovementEventHistory::Capacity>> MissedEvents;
+	Proxy_Events.GetMissedEvents(LastReplayedEventSequence, MissedEvents);
+	LastReplayedEventSequence = Proxy_Events.GetSequence();
+
+	for (const FExhibitionMovementEvent* Event : MissedEvents)
 	{
-		CharacterOwner->PlayAnimMontage(FlyingDiveMontage);
+		ReplayProxyEvent(*Event);
 	}
-	else
+}
+
+void UExhibitionMovementComponent::PushProxyEvent(const FExhibitionMovementEvent& Event)
+{
+	if (IsServer())
+	{
+		Proxy_Events.Push(Event);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UExhibitionMovementComponent, Proxy_Events, this);
+	}
+}
+
+void UExhibitionMovementComponent::ReplayProxyEvent(const FExhibitionMovementEvent& Event)
+{
+	switch (Event.Type)
 	{
-		// else he requested a dodge
-		CharacterOwner->PlayAnimMontage(DodgeBackMontage);
+	case EExhibitionMovementEvent::Dive:
+		switch (static_cast<EExhibitionDiveType>(Event.Variant))
+		{
+		case EExhibitionDiveType::Dive:
+			CharacterOwner->PlayAnimMontage(DiveMontage);
+			OnDive.Broadcast();
+			break;
+		case EExhibitionDiveType::FlyingDive:
+			CharacterOwner->PlayAnimMontage(FlyingDiveMontage);
+			break;
+		default:
+			CharacterOwner->PlayAnimMontage(DodgeBackMontage);
+			break;
+		}
+		break;
+	case EExhibitionMovementEvent::JumpExtra:
+		CharacterOwner->PlayAnimMontage(JumpExtraMontage);
+		break;
+	case EExhibitionMovementEvent::Hook:
+		ApplyHookTarget(Event.Target.Get(), Event.Location);
+		break;
+	case EExhibitionMovementEvent::Rope:
+		CharacterOwner->PlayAnimMontage(HangToRopeMontage);
+		ApplyRopeTarget(Event.Location, Event.Normal);
+		break;
 	}
 }
 
-void UExhibitionMovementComponent::OnRep_JumpExtra()
+void UExhibitionMovementComponent::ApplyHookTarget(AActor* Hook, const FVector& Destination)
 {
-	CharacterOwner->PlayAnimMontage(JumpExtraMontage);
+	// The hook actor may not be resolved on this client yet, the destination is all the travel needs
+	CurrentHook = Hook;
+	PrepareTravel(HOOK_TRAVEL_NAME, Destination, ReleaseHookTolerance, FVector::ZeroVector, MaxHookSpeed, HookCurve);
+
+	// The movement mode replicated first, EnterHook ran without a destination
+	if (IsHooking())
+	{
+		RemoveRootMotionSource(FName(HOOK_TRAVEL_NAME));
+		ApplyTravel();
+	}
 }
 
-void UExhibitionMovementComponent::OnRep_FindHook()
+void UExhibitionMovementComponent::ApplyRopeTarget(const FVector& Destination, const FVector& Normal)
 {
-	TryHook();
+	PrepareTravel(ROPE_TRAVEL_NAME, Destination, RopeReleaseTolerance, Normal, MaxRopeSpeed, RopeSpeedCurve);
+
+	// The movement mode replicated first, EnterRope ran without a destination
+	if (IsOnRope())
+	{
+		RemoveRootMotionSource(FName(ROPE_TRAVEL_NAME));
+		ApplyTravel();
+	}
 }
 
-void UExhibitionMovementComponent::OnRep_FindRope()
+void UExhibitionMovementComponent::UpdateNetUpdateFrequency(const float DeltaSeconds, const bool bForce)
 {
-	CharacterOwner->PlayAnimMontage(HangToRopeMontage);
+	if (CharacterOwner == nullptr || NetUpdatePolicy == nullptr || !IsServer())
+	{
+		return;
+	}
+
+	const float Speed = Velocity.Size();
+	if (Speed <= NetUpdatePolicy->GetIdleSpeed() && Acceleration.IsNearlyZero())
+	{
+		IdleTime += DeltaSeconds;
+	}
+	else
+	{
+		IdleTime = 0.f;
+	}
+
+	NetUpdatePolicyTimer -= DeltaSeconds;
+	if (!bForce && NetUpdatePolicyTimer > 0.f)
+	{
+		return;
+	}
+
+	NetUpdatePolicyTimer = NetUpdatePolicy->GetEvaluationInterval();
+
+	const bool bIdle = IsMovingOnGround() && IdleTime >= NetUpdatePolicy->GetIdleDelay();
+	float Frequency = 0.f, MinFrequency = 0.f;
+	NetUpdatePolicy->ComputeFrequencies(MovementMode, CustomMovementMode, Speed, bIdle, Frequency, MinFrequency);
+
+	const float PreviousFrequency = CharacterOwner->NetUpdateFrequency;
+	CharacterOwner->NetUpdateFrequency = Frequency;
+	CharacterOwner->MinNetUpdateFrequency = MinFrequency;
+
+	// Mode changes and waking up are the updates proxies cannot extrapolate, send them now
+	if (bForce || Frequency > PreviousFrequency * 2.f)
+	{
+		CharacterOwner->ForceNetUpdate();
+	}
 }
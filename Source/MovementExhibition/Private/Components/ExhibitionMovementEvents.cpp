@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ExhibitionMovementEvents.h"
+
+#include "UObject/CoreNet.h"
+
+void FExhibitionMovementEventHistory::Push(const FExhibitionMovementEvent& Event)
+{
+	if (Events.Num() == Capacity)
+	{
+		Events.RemoveAt(0, 1, false);
+	}
+
+	Events.Add(Event);
+	++Sequence;
+}
+
+int32 FExhibitionMovementEventHistory::GetMissedEvents(const uint8 LastSequence, TArray<const FExhibitionMovementEvent*, TInlineAllocator<Capacity>>& OutEvents) const
+{
+	OutEvents.Reset();
+
+	// Unsigned difference handles the wrap around, anything older than the history is lost
+	const int32 NumMissed = FMath::Min<int32>(static_cast<uint8>(Sequence - LastSequence), Events.Num());
+	for (int32 Index = Events.Num() - NumMissed; Index < Events.Num(); ++Index)
+	{
+		OutEvents.Add(&Events[Index]);
+	}
+
+	return NumMissed;
+}
+
+bool FExhibitionMovementEventHistory::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	Ar << Sequence;
+
+	uint32 NumEvents = Events.Num();
+	Ar.SerializeInt(NumEvents, Capacity + 1);
+	if (Ar.IsLoading())
+	{
+		Events.SetNum(FMath::Min<int32>(NumEvents, Capacity));
+	}
+
+	for (FExhibitionMovementEvent& Event : Events)
+	{
+		uint8 Type = static_cast<uint8>(Event.Type);
+		Ar.SerializeBits(&Type, 2);
+		Event.Type = static_cast<EExhibitionMovementEvent>(Type);
+
+		switch (Event.Type)
+		{
+		case EExhibitionMovementEvent::Dive:
+			Ar.SerializeBits(&Event.Variant, 2);
+			break;
+		case EExhibitionMovementEvent::Hook:
+			{
+				// Not resolved yet on this client reads as null, the location is enough to travel
+				UObject* Target = Event.Target.Get();
+				Map->SerializeObject(Ar, AActor::StaticClass(), Target);
+				Event.Target = Cast<AActor>(Target);
+
+				bool bLocationSuccess = true;
+				Event.Location.NetSerialize(Ar, Map, bLocationSuccess);
+				bOutSuccess &= bLocationSuccess;
+			}
+			break;
+		case EExhibitionMovementEvent::Rope:
+			{
+				bool bLocationSuccess = true;
+				bool bNormalSuccess = true;
+				Event.Location.NetSerialize(Ar, Map, bLocationSuccess);
+				Event.Normal.NetSerialize(Ar, Map, bNormalSuccess);
+				bOutSuccess &= bLocationSuccess && bNormalSuccess;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ExhibitionNetUpdatePolicy.h"
+
+#include "Components/ExhibitionMovementComponent.h"
+
+UExhibitionNetUpdatePolicy::UExhibitionNetUpdatePolicy()
+{
+	Idle.NetUpdateFrequency = 2.f;
+	Idle.MinNetUpdateFrequency = 1.f;
+
+	Walking.NetUpdateFrequency = 30.f;
+	Walking.MinNetUpdateFrequency = 10.f;
+	Walking.FullRateSpeed = 500.f;
+
+	Falling.NetUpdateFrequency = 60.f;
+	Falling.MinNetUpdateFrequency = 20.f;
+
+	Dive.NetUpdateFrequency = 60.f;
+	Dive.MinNetUpdateFrequency = 30.f;
+
+	Slide.NetUpdateFrequency = 60.f;
+	Slide.MinNetUpdateFrequency = 30.f;
+	Slide.FullRateSpeed = 600.f;
+
+	Hook.NetUpdateFrequency = 5.f;
+	Hook.MinNetUpdateFrequency = 2.f;
+
+	Rope.NetUpdateFrequency = 5.f;
+	Rope.MinNetUpdateFrequency = 2.f;
+}
+
+const FExhibitionNetUpdateRate& UExhibitionNetUpdatePolicy::GetRate(const EMovementMode MovementMode, const uint8 CustomMovementMode, const bool bIdle) const
+{
+	if (bIdle)
+	{
+		return Idle;
+	}
+
+	switch (MovementMode)
+	{
+	case MOVE_Falling:
+		return Falling;
+	case MOVE_Flying:
+		return Dive;
+	case MOVE_Custom:
+		switch (CustomMovementMode)
+		{
+		case CMOVE_Slide:
+			return Slide;
+		case CMOVE_Hook:
+			return Hook;
+		case CMOVE_Rope:
+			return Rope;
+		default:
+			return Walking;
+		}
+	default:
+		return Walking;
+	}
+}
+
+void UExhibitionNetUpdatePolicy::ComputeFrequencies(const EMovementMode MovementMode, const uint8 CustomMovementMode, const float Speed, const bool bIdle, float& OutNetUpdateFrequency, float& OutMinNetUpdateFrequency) const
+{
+	const FExhibitionNetUpdateRate& Rate = GetRate(MovementMode, CustomMovementMode, bIdle);
+	const float MinFrequency = FMath::Min(Rate.MinNetUpdateFrequency, Rate.NetUpdateFrequency);
+
+	const float SpeedRatio = (Rate.FullRateSpeed > 0.f)? FMath::Clamp(Speed / Rate.FullRateSpeed, 0.f, 1.f) : 1.f;
+	OutNetUpdateFrequency = FMath::Lerp(MinFrequency, Rate.NetUpdateFrequency, SpeedRatio);
+	OutMinNetUpdateFrequency = MinFrequency;
+}
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ExhibitionSpringArmComponent.h"
+
+#include "Engine/World.h"
+#include "Stats/ExhibitionMovementStats.h"
+
+void UExhibitionSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+	if (!bAsyncProbe || !bDoTrace || TargetArmLength == 0.f)
+	{
+		ResetProbes();
+		Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+		return;
+	}
+
+	// Lag and socket placement without collision, the probe result is applied on top.
+	// PreviousDesiredLoc is the lagged pivot, the untraced camera end is the socket Super just placed.
+	Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+	const FVector ArmOrigin = PreviousArmOrigin;
+	const FVector DesiredLocation = GetComponentTransform().TransformPosition(RelativeSocketLocation);
+
+	CollectPendingProbe();
+
+	const float Motion = bHasProbe? FMath::Max(FVector::Dist(ArmOrigin, LastProbe.Origin), FVector::Dist(DesiredLocation, LastProbe.Desired)) : 0.f;
+	if (!bHasProbe || Motion > SyncProbeDistance)
+	{
+		ProbeNow(ArmOrigin, DesiredLocation);
+	}
+	else if (Motion > ProbeReuseTolerance)
+	{
+		RequestProbe(ArmOrigin, DesiredLocation);
+	}
+
+	const FVector HitLocation = FMath::Lerp(ArmOrigin, DesiredLocation, LastProbe.HitTime);
+	const FVector ResultLocation = BlendLocations(DesiredLocation, HitLocation, LastProbe.bBlockingHit, DeltaTime);
+
+	UnfixedCameraPosition = DesiredLocation;
+	bIsCameraFixed = ResultLocation != DesiredLocation;
+
+	RelativeSocketLocation = GetComponentTransform().InverseTransformPosition(ResultLocation);
+	UpdateChildTransforms();
+}
+
+void UExhibitionSpringArmComponent::CollectPendingProbe()
+{
+	// Async trace results are only readable during the frame after they were issued
+	if (!PendingProbe.IsValid() || PendingProbeFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	FTraceDatum TraceDatum;
+	if (GetWorld()->QueryTraceData(PendingProbe, TraceDatum))
+	{
+		const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits);
+		LastProbe.Origin = TraceDatum.Start;
+		LastProbe.Desired = TraceDatum.End;
+		LastProbe.bBlockingHit = Hit != nullptr;
+		LastProbe.HitTime = (Hit != nullptr)? Hit->Time : 1.f;
+		bHasProbe = true;
+	}
+
+	PendingProbe.Invalidate();
+}
+
+void UExhibitionSpringArmComponent::ProbeNow(const FVector& ArmOrigin, const FVector& DesiredLocation)
+{
+	FHitResult Hit;
+	GetWorld()->SweepSingleByChannel(Hit, ArmOrigin, DesiredLocation, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), GetProbeQueryParams());
+	EXHIBITION_MOVEMENT_COUNT(Traces, 1);
+
+	LastProbe.Origin = ArmOrigin;
+	LastProbe.Desired = DesiredLocation;
+	LastProbe.bBlockingHit = Hit.bBlockingHit;
+	LastProbe.HitTime = Hit.bBlockingHit? Hit.Time : 1.f;
+	bHasProbe = true;
+
+	// Already superseded
+	PendingProbe.Invalidate();
+}
+
+void UExhibitionSpringArmComponent::RequestProbe(const FVector& ArmOrigin, const FVector& DesiredLocation)
+{
+	if (PendingProbe.IsValid())
+	{
+		return;
+	}
+
+	PendingProbe = GetWorld()->AsyncSweepByChannel(
+		EAsyncTraceType::Single,
+		ArmOrigin,
+		DesiredLocation,
+		FQuat::Identity,
+		ProbeChannel,
+		FCollisionShape::MakeSphere(ProbeSize),
+		GetProbeQueryParams()
+	);
+	PendingProbeFrame = GFrameCounter;
+	EXHIBITION_MOVEMENT_COUNT(Traces, 1);
+}
+
+void UExhibitionSpringArmComponent::ResetProbes()
+{
+	bHasProbe = false;
+	PendingProbe.Invalidate();
+}
+
+FCollisionQueryParams UExhibitionSpringArmComponent::GetProbeQueryParams() const
+{
+	return FCollisionQueryParams(SCENE_QUERY_STAT(SpringArm), false, GetOwner());
+}
@@ -7,11 +7,25 @@
 #include "EnhancedInputSubsystems.h"
 #include "Characters/ExhibitionCharacter.h"
 #include "Components/ExhibitionMovementComponent.h"
+#include "Misc/CommandLine.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogExhibitionPlayerController, Log, All);
+
+void AExhibitionPlayerController::PlayerTick(float DeltaTime)
+{
+	Super::PlayerTick(DeltaTime);
+
+	if (BenchmarkInput.IsSet() && CharacterRef != nullptr && CharacterRef->GetExhibitionMovComponent() != nullptr)
+	{
+		BenchmarkInput->Tick(*CharacterRef, *CharacterRef->GetExhibitionMovComponent(), DeltaTime);
+	}
+}
 
 void AExhibitionPlayerController::AcknowledgePossession(APawn* P)
 {
 	Super::AcknowledgePossession(P);
 	CharacterRef = Cast<AExhibitionCharacter>(P);
+	StartBenchmarkInput();
 }
 
 void AExhibitionPlayerController::OnUnPossess()
@@ -53,6 +67,33 @@ void AExhibitionPlayerController::InitializeMappingContext()
 	}
 }
 
+void AExhibitionPlayerController::StartBenchmarkInput()
+{
+	FString ScenarioName;
+	if (BenchmarkInput.IsSet() || !IsLocalController() || !FParse::Value(FCommandLine::Get(), TEXT("BenchmarkScenario="), ScenarioName))
+	{
+		return;
+	}
+
+	const TArray<ExhibitionBenchmark::FScenario> Scenarios = ExhibitionBenchmark::MakeScenarios();
+	int32 ScenarioIndex = Scenarios.IndexOfByPredicate([&ScenarioName](const ExhibitionBenchmark::FScenario& Scenario) { return ScenarioName == Scenario.Name; });
+
+	// Every client is its own process, the process id spreads them over the scenarios
+	if (ScenarioName == TEXT("All"))
+	{
+		ScenarioIndex = FPlatformProcess::GetCurrentProcessId() % Scenarios.Num();
+	}
+
+	if (ScenarioIndex == INDEX_NONE)
+	{
+		UE_LOG(LogExhibitionPlayerController, Warning, TEXT("Unknown benchmark scenario %s"), *ScenarioName);
+		return;
+	}
+
+	UE_LOG(LogExhibitionPlayerController, Display, TEXT("Driving %s with benchmark scenario %s"), *GetNameSafe(CharacterRef), Scenarios[ScenarioIndex].Name);
+	BenchmarkInput.Emplace(Scenarios[ScenarioIndex]);
+}
+
 void AExhibitionPlayerController::RequestMove(const FInputActionValue& InputAction)
 {
 	ensure(CharacterRef != nullptr);
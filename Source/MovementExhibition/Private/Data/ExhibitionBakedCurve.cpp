@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ExhibitionBakedCurve.h"
+
+#include "Curves/CurveFloat.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogExhibitionBakedCurve, Log, All);
+
+static TAutoConsoleVariable<bool> CVarValidateBakedCurves(
+	TEXT("MovExhibition.Curves.ValidateBaked"),
+	false,
+	TEXT("Editor only. Logs the max error of every baked curve against its source curve when it is baked."),
+	ECVF_Default
+);
+
+void FExhibitionBakedCurve::Bake(const FRichCurve& Curve, const int32 Resolution, const TCHAR* DebugName)
+{
+	float MaxTime = 0.f;
+	Curve.GetTimeRange(MinTime, MaxTime);
+	if (MaxTime <= MinTime)
+	{
+		MaxTime = MinTime + 1.f;
+	}
+
+	const int32 NumSamples = FMath::Max(Resolution, 2);
+	const float Step = (MaxTime - MinTime) / (NumSamples - 1);
+	InvStep = 1.f / Step;
+
+	Samples.SetNumUninitialized(NumSamples);
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		Samples[i] = Curve.Eval(MinTime + Step * i);
+	}
+
+#if WITH_EDITOR
+	if (CVarValidateBakedCurves->GetBool())
+	{
+		float WorstTime = 0.f;
+		const float MaxError = MeasureMaxError(Curve, 8, &WorstTime);
+		UE_LOG(LogExhibitionBakedCurve, Display, TEXT("%s: %d samples, max error %f at %f"), (DebugName != nullptr)? DebugName : TEXT("Curve"), NumSamples, MaxError, WorstTime);
+	}
+#endif
+}
+
+void FExhibitionBakedCurve::Bake(const FRuntimeFloatCurve& Curve, const int32 Resolution, const TCHAR* DebugName)
+{
+	const FRichCurve* RichCurve = Curve.GetRichCurveConst();
+	if (RichCurve == nullptr)
+	{
+		Reset();
+		return;
+	}
+
+	Bake(*RichCurve, Resolution, DebugName);
+}
+
+void FExhibitionBakedCurve::Reset()
+{
+	Samples.Reset();
+	MinTime = 0.f;
+	InvStep = 0.f;
+}
+
+void FExhibitionBakedCurve::EvalBatch(TConstArrayView<float> Times, TArrayView<float> OutValues) const
+{
+	check(OutValues.Num() >= Times.Num());
+
+	const int32 Num = Times.Num();
+	if (!IsBaked())
+	{
+		for (int32 i = 0; i < Num; ++i)
+		{
+			OutValues[i] = 0.f;
+		}
+		return;
+	}
+
+	constexpr int32 VectorWidth = 4;
+	const VectorRegister4Float MinTimes = VectorSetFloat1(MinTime);
+	const VectorRegister4Float InvSteps = VectorSetFloat1(InvStep);
+	const VectorRegister4Float LastPosition = VectorSetFloat1(static_cast<float>(Samples.Num() - 1));
+	const VectorRegister4Float LastIndex = VectorSetFloat1(static_cast<float>(Samples.Num() - 2));
+
+	int32 Index = 0;
+	for (; Index + VectorWidth <= Num; Index += VectorWidth)
+	{
+		const VectorRegister4Float Positions = VectorMin(VectorMax(VectorMultiply(VectorSubtract(VectorLoad(Times.GetData() + Index), MinTimes), InvSteps), VectorZeroFloat()), LastPosition);
+		const VectorRegister4Float Floors = VectorMin(VectorFloor(Positions), LastIndex);
+		const VectorRegister4Float Alphas = VectorSubtract(Positions, Floors);
+
+		alignas(16) int32 SampleIndices[VectorWidth];
+		VectorIntStoreAligned(VectorFloatToInt(Floors), SampleIndices);
+
+		// No gather, the lerp itself stays vectorized
+		alignas(16) float From[VectorWidth];
+		alignas(16) float To[VectorWidth];
+		for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+		{
+			From[Lane] = Samples[SampleIndices[Lane]];
+			To[Lane] = Samples[SampleIndices[Lane] + 1];
+		}
+
+		const VectorRegister4Float Froms = VectorLoadAligned(From);
+		const VectorRegister4Float Values = VectorMultiplyAdd(VectorSubtract(VectorLoadAligned(To), Froms), Alphas, Froms);
+		VectorStore(Values, OutValues.GetData() + Index);
+	}
+
+	for (; Index < Num; ++Index)
+	{
+		OutValues[Index] = Eval(Times[Index]);
+	}
+}
+
+float FExhibitionBakedCurve::MeasureMaxError(const FRichCurve& Curve, const int32 SamplesPerStep, float* OutWorstTime) const
+{
+	if (!IsBaked() || InvStep <= 0.f)
+	{
+		return 0.f;
+	}
+
+	const int32 NumTimes = (Samples.Num() - 1) * FMath::Max(SamplesPerStep, 1) + 1;
+	const float Step = 1.f / (InvStep * FMath::Max(SamplesPerStep, 1));
+
+	TArray<float> Times;
+	Times.SetNumUninitialized(NumTimes);
+	for (int32 i = 0; i < NumTimes; ++i)
+	{
+		Times[i] = MinTime + Step * i;
+	}
+
+	TArray<float> Values;
+	Values.SetNumUninitialized(NumTimes);
+	EvalBatch(Times, Values);
+
+	float MaxError = 0.f;
+	for (int32 i = 0; i < NumTimes; ++i)
+	{
+		const float Error = FMath::Abs(Values[i] - Curve.Eval(Times[i]));
+		if (Error > MaxError)
+		{
+			MaxError = Error;
+			if (OutWorstTime != nullptr)
+			{
+				*OutWorstTime = Times[i];
+			}
+		}
+	}
+
+	return MaxError;
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ExhibitionHookReachabilityData.h"
+
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+bool UExhibitionHookReachabilityData::GetCellHooks(const FVector& Location, TConstArrayView<uint16>& OutHooks) const
+{
+	const int32 CellIndex = GetCellIndex(Location);
+	if (CellIndex == INDEX_NONE || !CellStarts.IsValidIndex(CellIndex + 1) || !BakedCells.IsValidIndex(CellIndex) || !BakedCells[CellIndex])
+	{
+		return false;
+	}
+
+	const int32 Start = CellStarts[CellIndex];
+	OutHooks = TConstArrayView<uint16>(CellHooks.GetData() + Start, CellStarts[CellIndex + 1] - Start);
+	return true;
+}
+
+int32 UExhibitionHookReachabilityData::GetCellIndex(const FVector& Location) const
+{
+	if (CellSize <= 0.f)
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector Local = (Location - Origin) / CellSize;
+	const int32 X = FMath::FloorToInt32(Local.X);
+	const int32 Y = FMath::FloorToInt32(Local.Y);
+	const int32 Z = FMath::FloorToInt32(Local.Z);
+	if (X < 0 || Y < 0 || Z < 0 || X >= Dimensions.X || Y >= Dimensions.Y || Z >= Dimensions.Z)
+	{
+		return INDEX_NONE;
+	}
+
+	const int64 CellIndex = int64(X) + int64(Dimensions.X) * (int64(Y) + int64(Dimensions.Y) * int64(Z));
+	return (CellIndex <= MAX_int32)? static_cast<int32>(CellIndex) : INDEX_NONE;
+}
+
+bool UExhibitionHookReachabilityData::IsCompatibleCapsule(const float Radius, const float HalfHeight) const
+{
+	return CapsuleRadius <= Radius + UE_KINDA_SMALL_NUMBER && CapsuleHalfHeight <= HalfHeight + UE_KINDA_SMALL_NUMBER;
+}
+
+FVector UExhibitionHookReachabilityData::GetCellCenter(const int32 CellIndex) const
+{
+	const int32 X = CellIndex % Dimensions.X;
+	const int32 Y = (CellIndex / Dimensions.X) % Dimensions.Y;
+	const int32 Z = CellIndex / (Dimensions.X * Dimensions.Y);
+	return Origin + (FVector(X, Y, Z) + 0.5f) * CellSize;
+}
+
+FString UExhibitionHookReachabilityData::GetPackageNameForWorld(const FString& WorldPackageName)
+{
+	return FString::Printf(TEXT("/Game/Game/Data/HookReachability/%s"), *GetAssetNameForWorld(WorldPackageName));
+}
+
+FString UExhibitionHookReachabilityData::GetAssetNameForWorld(const FString& WorldPackageName)
+{
+	const FString MapName = FPackageName::GetShortName(UWorld::RemovePIEPrefix(WorldPackageName));
+	return FString::Printf(TEXT("%s_HookReachability"), *MapName);
+}
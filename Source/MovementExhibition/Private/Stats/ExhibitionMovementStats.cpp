@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Stats/ExhibitionMovementStats.h"
+
+DEFINE_STAT(STAT_ExhibitionMovement_TryHook);
+DEFINE_STAT(STAT_ExhibitionMovement_TryHookAsync);
+DEFINE_STAT(STAT_ExhibitionMovement_CanUseHook);
+DEFINE_STAT(STAT_ExhibitionMovement_IsHookBlocked);
+DEFINE_STAT(STAT_ExhibitionMovement_ScoreHooks);
+DEFINE_STAT(STAT_ExhibitionMovement_UpdateHookCable);
+DEFINE_STAT(STAT_ExhibitionMovement_TryRope);
+DEFINE_STAT(STAT_ExhibitionMovement_QueryRopes);
+DEFINE_STAT(STAT_ExhibitionMovement_CanSlide);
+DEFINE_STAT(STAT_ExhibitionMovement_PhysSlide);
+DEFINE_STAT(STAT_ExhibitionMovement_PhysTravel);
+
+DEFINE_STAT(STAT_ExhibitionMovement_Traces);
+DEFINE_STAT(STAT_ExhibitionMovement_HookCandidates);
+DEFINE_STAT(STAT_ExhibitionMovement_RopeCandidates);
+DEFINE_STAT(STAT_ExhibitionMovement_CameraAssetMisses);
+
+CSV_DEFINE_CATEGORY_MODULE(MOVEMENTEXHIBITION_API, ExhibitionMovement, true);
+
+UE_TRACE_CHANNEL_DEFINE(ExhibitionMovementChannel);
@@ -0,0 +1,343 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ExhibitionHookSubsystem.h"
+
+#include "CollisionShape.h"
+#include "Data/ExhibitionHookReachabilityData.h"
+#include "Engine/World.h"
+#include "Stats/ExhibitionMovementStats.h"
+
+static TAutoConsoleVariable<float> CVarHookGridCellSize(
+	TEXT("MovExhibition.Hook.GridCellSize"),
+	2500.f,
+	TEXT("Cell size of the hook registry grid. Applied when the world is initialized."),
+	ECVF_Default
+);
+
+namespace ExhibitionHookScoring
+{
+	constexpr int32 VectorWidth = 4;
+
+	// Num must be a multiple of VectorWidth
+	static void ScoreBatch(const float* X, const float* Y, const float* Z, const int32 Num, const float LookX, const float LookY, float* OutDistSqr, float* OutDot)
+	{
+		const VectorRegister4Float LookXs = VectorSetFloat1(LookX);
+		const VectorRegister4Float LookYs = VectorSetFloat1(LookY);
+		const VectorRegister4Float MinLength = VectorSetFloat1(UE_SMALL_NUMBER);
+
+		for (int32 Index = 0; Index < Num; Index += VectorWidth)
+		{
+			const VectorRegister4Float Xs = VectorLoad(X + Index);
+			const VectorRegister4Float Ys = VectorLoad(Y + Index);
+			const VectorRegister4Float Zs = VectorLoad(Z + Index);
+
+			const VectorRegister4Float DistSqr2D = VectorMultiplyAdd(Ys, Ys, VectorMultiply(Xs, Xs));
+			const VectorRegister4Float DistSqr = VectorMultiplyAdd(Zs, Zs, DistSqr2D);
+
+			// Same as (Look | ToHook.GetSafeNormal2D()), hooks right above the character end up with a zero dot
+			const VectorRegister4Float Length2D = VectorMax(VectorSqrt(DistSqr2D), MinLength);
+			const VectorRegister4Float Dot = VectorDivide(VectorMultiplyAdd(LookYs, Ys, VectorMultiply(LookXs, Xs)), Length2D);
+
+			VectorStore(DistSqr, OutDistSqr + Index);
+			VectorStore(Dot, OutDot + Index);
+		}
+	}
+}
+
+void UExhibitionHookSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Grid.SetCellSize(CVarHookGridCellSize->GetFloat());
+}
+
+void UExhibitionHookSubsystem::Deinitialize()
+{
+	for (const FHookEntry& Entry : Hooks)
+	{
+		if (AActor* Hook = Entry.Actor.Get())
+		{
+			UnbindEndPlay(Hook);
+			if (USceneComponent* Root = Hook->GetRootComponent())
+			{
+				Root->TransformUpdated.RemoveAll(this);
+			}
+		}
+	}
+
+	Hooks.Empty();
+	HookIndices.Empty();
+	HookX.Empty();
+	HookY.Empty();
+	HookZ.Empty();
+	MovableRoots.Empty();
+	Grid.Reset();
+	ReachabilityData = nullptr;
+	BakedToRegistry.Empty();
+	BakedHookIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UExhibitionHookSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadReachabilityData();
+}
+
+void UExhibitionHookSubsystem::RegisterHook(AActor* Hook)
+{
+	if (Hook == nullptr || HookIndices.Contains(Hook))
+	{
+		return;
+	}
+
+	FHookEntry Entry;
+	Entry.Actor = Hook;
+	Entry.Location = Hook->GetActorLocation();
+
+	const int32 Index = Hooks.Add(Entry);
+	HookIndices.Add(Hook, Index);
+	Grid.Add(Index, FBox(Entry.Location, Entry.Location));
+
+	if (Index >= HookX.Num())
+	{
+		HookX.SetNumZeroed(Index + 1);
+		HookY.SetNumZeroed(Index + 1);
+		HookZ.SetNumZeroed(Index + 1);
+	}
+	SetHookLocation(Index, Entry.Location);
+	MapBakedHook(Hook, Index);
+
+	BindEndPlay(Hook);
+
+	// Static hooks never move, only listen to the ones that can
+	USceneComponent* Root = Hook->GetRootComponent();
+	if (Root != nullptr && Root->Mobility == EComponentMobility::Movable)
+	{
+		Root->TransformUpdated.AddUObject(this, &UExhibitionHookSubsystem::OnHookTransformUpdated);
+		MovableRoots.Add(Root, Index);
+	}
+}
+
+void UExhibitionHookSubsystem::UnregisterHook(AActor* Hook)
+{
+	int32 Index = INDEX_NONE;
+	if (Hook == nullptr || !HookIndices.RemoveAndCopyValue(Hook, Index))
+	{
+		return;
+	}
+
+	const FVector Location = Hooks[Index].Location;
+	Grid.Remove(Index, FBox(Location, Location));
+	Hooks.RemoveAt(Index);
+	MapBakedHook(Hook, INDEX_NONE);
+
+	UnbindEndPlay(Hook);
+	if (USceneComponent* Root = Hook->GetRootComponent())
+	{
+		Root->TransformUpdated.RemoveAll(this);
+		MovableRoots.Remove(Root);
+	}
+}
+
+bool UExhibitionHookSubsystem::ScoreHooks(const FName& Tag, const FVector& Origin, const FVector& LookDirection, const FCollisionShape& Capsule, const float Radius, const float MinDot, const int32 FirstCandidate, const int32 MaxCandidates, TArray<FExhibitionHookScore>& OutShortlist) const
+{
+	EXHIBITION_MOVEMENT_SCOPE(ScoreHooks);
+
+	OutShortlist.Reset();
+	QueryScratch.Reset();
+
+	const bool bBaked = GatherBakedCandidates(Tag, Origin, Capsule, Radius);
+	if (!bBaked)
+	{
+		Grid.Query(FBox(Origin - FVector(Radius), Origin + FVector(Radius)), QueryScratch);
+	}
+
+	EXHIBITION_MOVEMENT_COUNT(HookCandidates, QueryScratch.Num());
+	if (QueryScratch.IsEmpty() || MaxCandidates <= 0)
+	{
+		return bBaked;
+	}
+
+	// Gather relative to the origin so the kernel can run in single precision
+	const int32 NumCandidates = QueryScratch.Num();
+	const int32 NumPadded = Align(NumCandidates, ExhibitionHookScoring::VectorWidth);
+	ScoreX.SetNumUninitialized(NumPadded, false);
+	ScoreY.SetNumUninitialized(NumPadded, false);
+	ScoreZ.SetNumUninitialized(NumPadded, false);
+	ScoreDistSqr.SetNumUninitialized(NumPadded, false);
+	ScoreDot.SetNumUninitialized(NumPadded, false);
+
+	for (int32 Slot = 0; Slot < NumCandidates; ++Slot)
+	{
+		const int32 Index = QueryScratch[Slot];
+		ScoreX[Slot] = static_cast<float>(HookX[Index] - Origin.X);
+		ScoreY[Slot] = static_cast<float>(HookY[Index] - Origin.Y);
+		ScoreZ[Slot] = static_cast<float>(HookZ[Index] - Origin.Z);
+	}
+
+	for (int32 Slot = NumCandidates; Slot < NumPadded; ++Slot)
+	{
+		ScoreX[Slot] = ScoreY[Slot] = ScoreZ[Slot] = 0.f;
+	}
+
+	const FVector Look = LookDirection.GetSafeNormal2D();
+	ExhibitionHookScoring::ScoreBatch(ScoreX.GetData(), ScoreY.GetData(), ScoreZ.GetData(), NumPadded, Look.X, Look.Y, ScoreDistSqr.GetData(), ScoreDot.GetData());
+
+	// Keep the best ranked hooks up to the end of the requested page, sorted by insertion
+	const int32 MaxRanked = FirstCandidate + MaxCandidates;
+	const float RadiusSqr = FMath::Square(Radius);
+	for (int32 Slot = 0; Slot < NumCandidates; ++Slot)
+	{
+		FExhibitionHookScore Score;
+		Score.DistSqr = ScoreDistSqr[Slot];
+		Score.DotResult = ScoreDot[Slot];
+		if (Score.DistSqr > RadiusSqr || Score.DotResult < MinDot)
+		{
+			continue;
+		}
+
+		if (OutShortlist.Num() == MaxRanked && !Score.IsBetterThan(OutShortlist.Last()))
+		{
+			continue;
+		}
+
+		Score.Hook = Hooks[QueryScratch[Slot]].Actor.Get();
+		if (Score.Hook == nullptr || !Score.Hook->ActorHasTag(Tag))
+		{
+			continue;
+		}
+
+		if (OutShortlist.Num() == MaxRanked)
+		{
+			OutShortlist.Pop(false);
+		}
+
+		int32 InsertAt = OutShortlist.Num();
+		while (InsertAt > 0 && Score.IsBetterThan(OutShortlist[InsertAt - 1]))
+		{
+			--InsertAt;
+		}
+
+		OutShortlist.Insert(Score, InsertAt);
+	}
+
+	OutShortlist.RemoveAt(0, FMath::Min(FirstCandidate, OutShortlist.Num()), false);
+	return bBaked;
+}
+
+void UExhibitionHookSubsystem::RegisterTrackedActor(AActor* Actor)
+{
+	RegisterHook(Actor);
+}
+
+void UExhibitionHookSubsystem::UnregisterTrackedActor(AActor* Actor)
+{
+	UnregisterHook(Actor);
+}
+
+void UExhibitionHookSubsystem::OnHookTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	const int32* Index = MovableRoots.Find(Component);
+	if (Index == nullptr)
+	{
+		return;
+	}
+
+	FHookEntry& Entry = Hooks[*Index];
+	const FVector NewLocation = Component->GetComponentLocation();
+	if (NewLocation.Equals(Entry.Location))
+	{
+		return;
+	}
+
+	Grid.Remove(*Index, FBox(Entry.Location, Entry.Location));
+	Entry.Location = NewLocation;
+	Grid.Add(*Index, FBox(Entry.Location, Entry.Location));
+	SetHookLocation(*Index, NewLocation);
+}
+
+void UExhibitionHookSubsystem::SetHookLocation(const int32 Index, const FVector& Location)
+{
+	HookX[Index] = Location.X;
+	HookY[Index] = Location.Y;
+	HookZ[Index] = Location.Z;
+}
+
+void UExhibitionHookSubsystem::LoadReachabilityData()
+{
+	const FString WorldPackageName = GetWorld()->GetOutermost()->GetName();
+	const FString ObjectPath = FString::Printf(
+		TEXT("%s.%s"),
+		*UExhibitionHookReachabilityData::GetPackageNameForWorld(WorldPackageName),
+		*UExhibitionHookReachabilityData::GetAssetNameForWorld(WorldPackageName)
+	);
+
+	// Baking is optional, levels without data fall back to the grid
+	ReachabilityData = LoadObject<UExhibitionHookReachabilityData>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+	BakedToRegistry.Reset();
+	BakedHookIndices.Reset();
+	if (ReachabilityData == nullptr)
+	{
+		return;
+	}
+
+	BakedToRegistry.Init(INDEX_NONE, ReachabilityData->HookNames.Num());
+	for (int32 BakedIndex = 0; BakedIndex < ReachabilityData->HookNames.Num(); ++BakedIndex)
+	{
+		BakedHookIndices.Add(ReachabilityData->HookNames[BakedIndex], BakedIndex);
+	}
+
+	for (const TPair<TObjectKey<AActor>, int32>& Pair : HookIndices)
+	{
+		MapBakedHook(Pair.Key.ResolveObjectPtr(), Pair.Value);
+	}
+}
+
+void UExhibitionHookSubsystem::MapBakedHook(const AActor* Hook, const int32 Index)
+{
+	// Only actors saved in the persistent level keep the name they were baked with
+	if (Hook == nullptr || ReachabilityData == nullptr || Hook->GetLevel() != GetWorld()->PersistentLevel)
+	{
+		return;
+	}
+
+	if (const int32* BakedIndex = BakedHookIndices.Find(Hook->GetFName()))
+	{
+		BakedToRegistry[*BakedIndex] = Index;
+	}
+}
+
+bool UExhibitionHookSubsystem::GatherBakedCandidates(const FName& Tag, const FVector& Origin, const FCollisionShape& Capsule, const float Radius) const
+{
+	if (ReachabilityData == nullptr || ReachabilityData->HookTag != Tag || ReachabilityData->MaxHookDistance < Radius)
+	{
+		return false;
+	}
+
+	// A smaller baked capsule only lets blocked hooks through, they are swept again anyway. A larger one would hide visible hooks.
+	if (!ReachabilityData->IsCompatibleCapsule(Capsule.GetCapsuleRadius(), Capsule.GetCapsuleHalfHeight()))
+	{
+		return false;
+	}
+
+	TConstArrayView<uint16> CellHooks;
+	if (!ReachabilityData->GetCellHooks(Origin, CellHooks))
+	{
+		return false;
+	}
+
+	for (const uint16 BakedIndex : CellHooks)
+	{
+		const int32 Index = BakedToRegistry[BakedIndex];
+		if (Index != INDEX_NONE)
+		{
+			QueryScratch.Add(Index);
+		}
+	}
+
+	return true;
+}
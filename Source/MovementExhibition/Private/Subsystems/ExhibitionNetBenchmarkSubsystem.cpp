@@ -0,0 +1,193 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ExhibitionNetBenchmarkSubsystem.h"
+
+#include "Benchmark/ExhibitionBenchmark.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNetBenchmark, Log, All);
+
+bool UExhibitionNetBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("NetBenchmark"));
+}
+
+void UExhibitionNetBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Clients launched with -NetBenchmark by mistake have nothing to record
+	if (InWorld.GetNetMode() != NM_DedicatedServer && InWorld.GetNetMode() != NM_ListenServer)
+	{
+		return;
+	}
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("BenchmarkClients="), ExpectedClients);
+	FParse::Value(CommandLine, TEXT("BenchmarkWarmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("BenchmarkDuration="), CaptureSeconds);
+	ExpectedClients = FMath::Max(ExpectedClients, 1);
+	WarmupSeconds = FMath::Max(WarmupSeconds, 0.f);
+	CaptureSeconds = FMath::Max(CaptureSeconds, 1.f);
+
+	const UNetDriver* NetDriver = InWorld.GetNetDriver();
+	const TCHAR* ReplicationPath = (NetDriver != nullptr && NetDriver->IsUsingIrisReplication())? TEXT("Iris") : TEXT("Legacy");
+	OutputFile = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("NetBenchmark_%s_%d_%s.json"), ReplicationPath, ExpectedClients, *FDateTime::Now().ToString());
+	FParse::Value(CommandLine, TEXT("BenchmarkOutput="), OutputFile);
+
+	UE_LOG(LogNetBenchmark, Display, TEXT("Waiting for %d clients (%s replication)"), ExpectedClients, ReplicationPath);
+	Phase = EPhase::WaitingForClients;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void UExhibitionNetBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = FPlatformTime::Seconds();
+	switch (Phase)
+	{
+	case EPhase::WaitingForClients:
+		if (GetNumConnectedClients() >= ExpectedClients)
+		{
+			UE_LOG(LogNetBenchmark, Display, TEXT("%d clients connected, warming up for %.0fs"), ExpectedClients, WarmupSeconds);
+			Phase = EPhase::Warmup;
+			PhaseStartTime = Now;
+		}
+		break;
+
+	case EPhase::Warmup:
+		if (Now - PhaseStartTime >= WarmupSeconds)
+		{
+			StartCapture();
+			Phase = EPhase::Capture;
+			PhaseStartTime = Now;
+		}
+		break;
+
+	case EPhase::Capture:
+		// Same measure as the Game line of stat unit: the game thread time of the last frame, idle waits excluded
+		FrameSamples.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		if (Now - PhaseStartTime >= CaptureSeconds)
+		{
+			FinishCapture();
+			Phase = EPhase::Done;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+TStatId UExhibitionNetBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExhibitionNetBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+bool UExhibitionNetBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game;
+}
+
+int32 UExhibitionNetBenchmarkSubsystem::GetNumConnectedClients() const
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr)
+	{
+		return 0;
+	}
+
+	int32 NumClients = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection != nullptr && Connection->PlayerController != nullptr)
+		{
+			++NumClients;
+		}
+	}
+
+	return NumClients;
+}
+
+void UExhibitionNetBenchmarkSubsystem::StartCapture()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	StartOutBytes = NetDriver->OutTotalBytes;
+	StartInBytes = NetDriver->InTotalBytes;
+	StartOutPackets = NetDriver->OutTotalPackets;
+	FrameSamples.Reset();
+
+	UE_LOG(LogNetBenchmark, Display, TEXT("Capturing for %.0fs"), CaptureSeconds);
+}
+
+void UExhibitionNetBenchmarkSubsystem::FinishCapture()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const double Elapsed = FPlatformTime::Seconds() - PhaseStartTime;
+	const int32 NumClients = GetNumConnectedClients();
+
+	// Totals are 32 bits and may wrap during a long capture, unsigned differences stay right
+	const double OutBytesPerSecond = static_cast<uint32>(NetDriver->OutTotalBytes - StartOutBytes) / Elapsed;
+	const double InBytesPerSecond = static_cast<uint32>(NetDriver->InTotalBytes - StartInBytes) / Elapsed;
+	const double OutPacketsPerSecond = static_cast<uint32>(NetDriver->OutTotalPackets - StartOutPackets) / Elapsed;
+
+	FrameSamples.Sort();
+	double Total = 0.0;
+	for (const double Sample : FrameSamples)
+	{
+		Total += Sample;
+	}
+
+	const double Mean = FrameSamples.IsEmpty()? 0.0 : Total / FrameSamples.Num();
+	const double P50 = FrameSamples.IsEmpty()? 0.0 : ExhibitionBenchmark::Percentile(FrameSamples, 0.5);
+	const double P99 = FrameSamples.IsEmpty()? 0.0 : ExhibitionBenchmark::Percentile(FrameSamples, 0.99);
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	Report->SetStringField(TEXT("Replication"), NetDriver->IsUsingIrisReplication()? TEXT("Iris") : TEXT("Legacy"));
+	Report->SetNumberField(TEXT("ExpectedClients"), ExpectedClients);
+	Report->SetNumberField(TEXT("Clients"), NumClients);
+	Report->SetNumberField(TEXT("Seconds"), Elapsed);
+	Report->SetNumberField(TEXT("Frames"), FrameSamples.Num());
+	Report->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+
+	TSharedRef<FJsonObject> GameThread = MakeShared<FJsonObject>();
+	GameThread->SetNumberField(TEXT("MeanMs"), Mean);
+	GameThread->SetNumberField(TEXT("P50Ms"), P50);
+	GameThread->SetNumberField(TEXT("P99Ms"), P99);
+	GameThread->SetNumberField(TEXT("MaxMs"), FrameSamples.IsEmpty()? 0.0 : FrameSamples.Last());
+	Report->SetObjectField(TEXT("ServerGameThread"), GameThread);
+
+	TSharedRef<FJsonObject> Bandwidth = MakeShared<FJsonObject>();
+	Bandwidth->SetNumberField(TEXT("OutBytesPerSecond"), OutBytesPerSecond);
+	Bandwidth->SetNumberField(TEXT("OutBytesPerSecondPerClient"), OutBytesPerSecond / FMath::Max(NumClients, 1));
+	Bandwidth->SetNumberField(TEXT("InBytesPerSecond"), InBytesPerSecond);
+	Bandwidth->SetNumberField(TEXT("OutPacketsPerSecond"), OutPacketsPerSecond);
+	Report->SetObjectField(TEXT("ServerBandwidth"), Bandwidth);
+
+	UE_LOG(LogNetBenchmark, Display, TEXT("%d clients: game thread mean %.2fms p50 %.2fms p99 %.2fms, out %.0f B/s (%.0f B/s per client), in %.0f B/s"),
+		NumClients, Mean, P50, P99, OutBytesPerSecond, OutBytesPerSecond / FMath::Max(NumClients, 1), InBytesPerSecond);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputFile), true);
+	const bool bSaved = FFileHelper::SaveStringToFile(Json, *OutputFile);
+	UE_LOG(LogNetBenchmark, Display, TEXT("%s %s"), bSaved? TEXT("Saved") : TEXT("Failed to save"), *OutputFile);
+
+	// The harness waits for the server to exit before starting the next run
+	FPlatformMisc::RequestExit(false);
+}
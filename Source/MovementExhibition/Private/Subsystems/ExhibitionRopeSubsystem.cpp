@@ -0,0 +1,254 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ExhibitionRopeSubsystem.h"
+
+#include "CableComponent.h"
+#include "Engine/World.h"
+#include "Stats/ExhibitionMovementStats.h"
+
+static TAutoConsoleVariable<float> CVarRopeGridCellSize(
+	TEXT("MovExhibition.Rope.GridCellSize"),
+	1000.f,
+	TEXT("Cell size of the rope registry grid. Applied when the world is initialized."),
+	ECVF_Default
+);
+
+void UExhibitionRopeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Grid.SetCellSize(CVarRopeGridCellSize->GetFloat());
+}
+
+void UExhibitionRopeSubsystem::Deinitialize()
+{
+	for (const FRopeEntry& Entry : Ropes)
+	{
+		if (AActor* Rope = Entry.Actor.Get())
+		{
+			UnbindEndPlay(Rope);
+		}
+
+		for (const TWeakObjectPtr<USceneComponent>& Watched : Entry.Watched)
+		{
+			if (USceneComponent* Component = Watched.Get())
+			{
+				Component->TransformUpdated.RemoveAll(this);
+			}
+		}
+	}
+
+	Ropes.Empty();
+	RopeIndices.Empty();
+	WatchedComponents.Empty();
+	Grid.Reset();
+
+	Super::Deinitialize();
+}
+
+void UExhibitionRopeSubsystem::RegisterRope(AActor* Rope)
+{
+	if (Rope == nullptr || RopeIndices.Contains(Rope))
+	{
+		return;
+	}
+
+	UCableComponent* Cable = Rope->FindComponentByClass<UCableComponent>();
+	if (Cable == nullptr)
+	{
+		return;
+	}
+
+	FRopeEntry Entry;
+	Entry.Actor = Rope;
+	Entry.Cable = Cable;
+	const int32 Index = Ropes.Add(Entry);
+	RopeIndices.Add(Rope, Index);
+
+	// The start follows the cable, the end follows whatever it is attached to
+	WatchComponent(Cable, Index);
+	if (USceneComponent* EndComponent = Cast<USceneComponent>(Cable->AttachEndTo.GetComponent(Rope)))
+	{
+		WatchComponent(EndComponent, Index);
+	}
+
+	RefreshRope(Index);
+	BindEndPlay(Rope);
+}
+
+void UExhibitionRopeSubsystem::UnregisterRope(AActor* Rope)
+{
+	int32 Index = INDEX_NONE;
+	if (Rope == nullptr || !RopeIndices.RemoveAndCopyValue(Rope, Index))
+	{
+		return;
+	}
+
+	FRopeEntry& Entry = Ropes[Index];
+	if (Entry.Bounds.IsValid)
+	{
+		Grid.Remove(Index, Entry.Bounds);
+	}
+
+	for (const TWeakObjectPtr<USceneComponent>& Watched : Entry.Watched)
+	{
+		USceneComponent* Component = Watched.Get();
+		if (Component == nullptr)
+		{
+			continue;
+		}
+
+		WatchedComponents.RemoveSingle(Component, Index);
+		if (!WatchedComponents.Contains(Component))
+		{
+			Component->TransformUpdated.RemoveAll(this);
+		}
+	}
+
+	Ropes.RemoveAt(Index);
+	UnbindEndPlay(Rope);
+}
+
+void UExhibitionRopeSubsystem::QueryRopes(const FName& Tag, const FBox& Bounds, TArray<FExhibitionRopeSegment>& OutRopes) const
+{
+	EXHIBITION_MOVEMENT_SCOPE(QueryRopes);
+
+	OutRopes.Reset();
+	QueryScratch.Reset();
+
+	Grid.Query(Bounds, QueryScratch);
+	for (const int32 Index : QueryScratch)
+	{
+		const FRopeEntry& Entry = Ropes[Index];
+		if (!Entry.Bounds.Intersect(Bounds))
+		{
+			continue;
+		}
+
+		AActor* Rope = Entry.Actor.Get();
+		UCableComponent* Cable = Entry.Cable.Get();
+		if (Rope == nullptr || Cable == nullptr || !Rope->ActorHasTag(Tag))
+		{
+			continue;
+		}
+
+		FExhibitionRopeSegment& Segment = OutRopes.AddDefaulted_GetRef();
+		Segment.Rope = Rope;
+		Segment.Cable = Cable;
+		Segment.Start = Entry.Start;
+		Segment.End = Entry.End;
+	}
+}
+
+bool UExhibitionRopeSubsystem::FindRope(const AActor* Rope, FExhibitionRopeSegment& OutRope) const
+{
+	const int32* Index = RopeIndices.Find(Rope);
+	if (Index == nullptr)
+	{
+		return false;
+	}
+
+	const FRopeEntry& Entry = Ropes[*Index];
+	OutRope.Rope = Entry.Actor.Get();
+	OutRope.Cable = Entry.Cable.Get();
+	OutRope.Start = Entry.Start;
+	OutRope.End = Entry.End;
+	return OutRope.Rope != nullptr && OutRope.Cable != nullptr;
+}
+
+void UExhibitionRopeSubsystem::GetRopePositions(const UCableComponent* Rope, FVector& StartPosition, FVector& EndPosition)
+{
+	if (Rope == nullptr)
+	{
+		return;
+	}
+
+	StartPosition = Rope->GetComponentLocation();
+	const USceneComponent* EndComponent = Cast<USceneComponent>(Rope->AttachEndTo.GetComponent(Rope->GetOwner()));
+	if(EndComponent == nullptr)
+	{
+		EndComponent = Rope;
+	}
+
+	if (Rope->AttachEndToSocketName != NAME_None)
+	{
+		EndPosition = EndComponent->GetSocketTransform(Rope->AttachEndToSocketName).TransformPosition(Rope->EndLocation);
+	}
+	else
+	{
+		EndPosition = EndComponent->GetComponentTransform().TransformPosition(Rope->EndLocation);
+	}
+}
+
+void UExhibitionRopeSubsystem::RegisterTrackedActor(AActor* Actor)
+{
+	RegisterRope(Actor);
+}
+
+void UExhibitionRopeSubsystem::UnregisterTrackedActor(AActor* Actor)
+{
+	UnregisterRope(Actor);
+}
+
+void UExhibitionRopeSubsystem::OnRopeTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	TArray<int32, TInlineAllocator<4>> Dependent;
+	WatchedComponents.MultiFind(Component, Dependent);
+	for (const int32 Index : Dependent)
+	{
+		RefreshRope(Index);
+	}
+}
+
+void UExhibitionRopeSubsystem::WatchComponent(USceneComponent* Component, const int32 Index)
+{
+	FRopeEntry& Entry = Ropes[Index];
+	if (Entry.Watched.Contains(Component))
+	{
+		return;
+	}
+
+	Entry.Watched.Add(Component);
+
+	// Static components never move, their cached positions stay valid
+	if (Component->Mobility != EComponentMobility::Movable)
+	{
+		return;
+	}
+
+	if (!WatchedComponents.Contains(Component))
+	{
+		Component->TransformUpdated.AddUObject(this, &UExhibitionRopeSubsystem::OnRopeTransformUpdated);
+	}
+	WatchedComponents.Add(Component, Index);
+}
+
+void UExhibitionRopeSubsystem::RefreshRope(const int32 Index)
+{
+	FRopeEntry& Entry = Ropes[Index];
+	const UCableComponent* Cable = Entry.Cable.Get();
+	if (Cable == nullptr)
+	{
+		return;
+	}
+
+	FVector Start, End;
+	GetRopePositions(Cable, Start, End);
+
+	const FBox Bounds(Start.ComponentMin(End), Start.ComponentMax(End));
+	if (Entry.Bounds.IsValid)
+	{
+		if (Start.Equals(Entry.Start) && End.Equals(Entry.End))
+		{
+			return;
+		}
+
+		Grid.Remove(Index, Entry.Bounds);
+	}
+
+	Entry.Start = Start;
+	Entry.End = End;
+	Entry.Bounds = Bounds;
+	Grid.Add(Index, Bounds);
+}
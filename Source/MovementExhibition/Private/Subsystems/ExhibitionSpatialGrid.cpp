@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ExhibitionSpatialGrid.h"
+
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+
+FExhibitionSpatialGrid::FExhibitionSpatialGrid(const float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.f))
+{
+}
+
+void FExhibitionSpatialGrid::SetCellSize(const float InCellSize)
+{
+	// Changing the cell size invalidates every bucket, owners have to re-add their ids
+	ensure(Cells.IsEmpty());
+	CellSize = FMath::Max(InCellSize, 1.f);
+}
+
+void FExhibitionSpatialGrid::Add(const int32 Id, const FBox& Bounds)
+{
+	const FIntVector Min = ToCell(Bounds.Min);
+	const FIntVector Max = ToCell(Bounds.Max);
+	if (Min != Max)
+	{
+		++NumSpanningIds;
+	}
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).AddUnique(Id);
+			}
+		}
+	}
+}
+
+void FExhibitionSpatialGrid::Remove(const int32 Id, const FBox& Bounds)
+{
+	const FIntVector Min = ToCell(Bounds.Min);
+	const FIntVector Max = ToCell(Bounds.Max);
+	if (Min != Max)
+	{
+		--NumSpanningIds;
+	}
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				const FIntVector Cell(X, Y, Z);
+				if (TArray<int32, TInlineAllocator<4>>* Bucket = Cells.Find(Cell))
+				{
+					Bucket->RemoveSingleSwap(Id, false);
+					if (Bucket->IsEmpty())
+					{
+						Cells.Remove(Cell);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FExhibitionSpatialGrid::Query(const FBox& Bounds, TArray<int32>& OutIds) const
+{
+	const FIntVector Min = ToCell(Bounds.Min);
+	const FIntVector Max = ToCell(Bounds.Max);
+	const int64 RangeCells = int64(Max.X - Min.X + 1) * int64(Max.Y - Min.Y + 1) * int64(Max.Z - Min.Z + 1);
+	const int32 FirstId = OutIds.Num();
+
+	// Sparse maps: walking the occupied cells is cheaper than probing every cell of the range
+	if (RangeCells > Cells.Num())
+	{
+		for (const TPair<FIntVector, TArray<int32, TInlineAllocator<4>>>& Pair : Cells)
+		{
+			const FIntVector& Cell = Pair.Key;
+			if (Cell.X >= Min.X && Cell.X <= Max.X && Cell.Y >= Min.Y && Cell.Y <= Max.Y && Cell.Z >= Min.Z && Cell.Z <= Max.Z)
+			{
+				OutIds.Append(Pair.Value);
+			}
+		}
+	}
+	else
+	{
+		for (int32 X = Min.X; X <= Max.X; ++X)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+				{
+					if (const TArray<int32, TInlineAllocator<4>>* Bucket = Cells.Find(FIntVector(X, Y, Z)))
+					{
+						OutIds.Append(*Bucket);
+					}
+				}
+			}
+		}
+	}
+
+	// Point ids live in a single cell, only ids spanning several cells can be reported twice
+	const int32 NumAppended = OutIds.Num() - FirstId;
+	if (NumSpanningIds > 0 && NumAppended > 1)
+	{
+		const TArrayView<int32> Appended(OutIds.GetData() + FirstId, NumAppended);
+		Algo::Sort(Appended);
+		OutIds.SetNum(FirstId + Algo::Unique(Appended), false);
+	}
+}
+
+void FExhibitionSpatialGrid::Reset()
+{
+	Cells.Reset();
+	NumSpanningIds = 0;
+}
+
+FIntVector FExhibitionSpatialGrid::ToCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize)
+	);
+}
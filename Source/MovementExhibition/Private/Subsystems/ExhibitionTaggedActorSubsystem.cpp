@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ExhibitionTaggedActorSubsystem.h"
+
+#include "EngineUtils.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+void UExhibitionTaggedActorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UExhibitionTaggedActorSubsystem::OnActorSpawned));
+
+	// Actors of streamed levels do not go through the spawn handler
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UExhibitionTaggedActorSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UExhibitionTaggedActorSubsystem::OnLevelRemoved);
+}
+
+void UExhibitionTaggedActorSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	TrackedTags.Empty();
+
+	Super::Deinitialize();
+}
+
+void UExhibitionTaggedActorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Tags tracked before begin play only saw the persistent level, catch up with everything loaded since
+	for (const FName& Tag : TrackedTags)
+	{
+		RegisterTaggedActors(Tag);
+	}
+}
+
+bool UExhibitionTaggedActorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UExhibitionTaggedActorSubsystem::TrackTag(const FName& Tag)
+{
+	if (Tag.IsNone())
+	{
+		return;
+	}
+
+	bool bAlreadyTracked = false;
+	TrackedTags.Add(Tag, &bAlreadyTracked);
+	if (!bAlreadyTracked)
+	{
+		RegisterTaggedActors(Tag);
+	}
+}
+
+void UExhibitionTaggedActorSubsystem::BindEndPlay(AActor* Actor)
+{
+	Actor->OnEndPlay.AddUniqueDynamic(this, &UExhibitionTaggedActorSubsystem::OnTrackedActorEndPlay);
+}
+
+void UExhibitionTaggedActorSubsystem::UnbindEndPlay(AActor* Actor)
+{
+	Actor->OnEndPlay.RemoveDynamic(this, &UExhibitionTaggedActorSubsystem::OnTrackedActorEndPlay);
+}
+
+void UExhibitionTaggedActorSubsystem::RegisterTaggedActors(const FName& Tag)
+{
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		if (It->ActorHasTag(Tag))
+		{
+			RegisterTrackedActor(*It);
+		}
+	}
+}
+
+bool UExhibitionTaggedActorSubsystem::HasTrackedTag(const AActor* Actor) const
+{
+	for (const FName& Tag : Actor->Tags)
+	{
+		if (TrackedTags.Contains(Tag))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UExhibitionTaggedActorSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (Actor != nullptr && HasTrackedTag(Actor))
+	{
+		RegisterTrackedActor(Actor);
+	}
+}
+
+void UExhibitionTaggedActorSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (Level == nullptr || World != GetWorld() || TrackedTags.IsEmpty())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor != nullptr && HasTrackedTag(Actor))
+		{
+			RegisterTrackedActor(Actor);
+		}
+	}
+}
+
+void UExhibitionTaggedActorSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (Level == nullptr || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor != nullptr)
+		{
+			UnregisterTrackedActor(Actor);
+		}
+	}
+}
+
+void UExhibitionTaggedActorSubsystem::OnTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterTrackedActor(Actor);
+}
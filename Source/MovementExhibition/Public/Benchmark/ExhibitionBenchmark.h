@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AExhibitionCharacter;
+class UExhibitionMovementComponent;
+
+/**
+ * Scripted input timelines and sample statistics shared by the movement benchmark commandlet
+ * and the networked benchmark.
+ */
+namespace ExhibitionBenchmark
+{
+	enum class EAction : uint8
+	{
+		ToggleSprint,
+		ToggleCrouch,
+		Jump,
+		StopJumping,
+		Dive,
+		RequestHook,
+		ReleaseHook,
+		Turn,
+	};
+
+	struct FInputEvent
+	{
+		float Time;
+		EAction Action;
+	};
+
+	// Timelines loop every Period seconds, the character always pushes forward
+	struct FScenario
+	{
+		const TCHAR* Name;
+		float Period;
+		TArray<FInputEvent> Events;
+	};
+
+	MOVEMENTEXHIBITION_API TArray<FScenario> MakeScenarios();
+
+	// Plays a scenario on a character, one call per frame
+	struct MOVEMENTEXHIBITION_API FScenarioPlayer
+	{
+		explicit FScenarioPlayer(const FScenario& InScenario);
+
+		// Applies the events due this frame and pushes the character forward
+		void Tick(AExhibitionCharacter& Character, UExhibitionMovementComponent& Movement, const float DeltaTime);
+
+		FScenario Scenario;
+		int32 NextEvent = 0;
+		float ScenarioTime = 0.f;
+	};
+
+	MOVEMENTEXHIBITION_API double Percentile(const TArray<double>& SortedSamples, const double Ratio);
+}
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Scene.h"
+
+struct FExhibitionBakedCurve;
+struct FMinimalViewInfo;
+class UMaterialInterface;
+
+struct FExhibitionCameraEffect
+{
+	float FOVOffset = 0.f;
+
+	float BlurAmount = 0.f;
+
+	float BlurMax = 0.f;
+
+	// Post process material blended with the effect weight. Not referenced by the stack, the owner keeps it alive.
+	UMaterialInterface* Material = nullptr;
+
+	float BlendInTime = 0.f;
+
+	float BlendOutTime = 0.f;
+
+	// Maps the blend alpha to the effect weight, linear when null. Not owned.
+	const FExhibitionBakedCurve* BlendCurve = nullptr;
+};
+
+/**
+ * Fixed-capacity stack of camera effects pushed by movement states.
+ * Effects blend in when pushed and out when released, then leave the stack. Every active effect is applied to the
+ * view in a single pass, on top of what the view target computed this frame.
+ */
+class MOVEMENTEXHIBITION_API FExhibitionCameraEffectStack
+{
+public:
+	static constexpr int32 Capacity = 8;
+
+	// Starts blending Effect in, or back in if Id is still blending out. False when the stack is full.
+	bool Push(const FName Id, const FExhibitionCameraEffect& Effect);
+
+	// Starts blending Id out, it leaves the stack once its weight reaches zero
+	void Release(const FName Id);
+
+	// Pushed and not released
+	bool IsActive(const FName Id) const;
+
+	void SetMaterial(const FName Id, UMaterialInterface* Material);
+
+	void Update(const float DeltaTime);
+
+	// Adds every active effect to the view, nothing to do while the stack is empty
+	void Apply(FMinimalViewInfo& POV);
+
+	void Reset();
+
+	FORCEINLINE bool IsEmpty() const { return Entries.IsEmpty(); }
+
+private:
+	struct FEntry
+	{
+		FName Id;
+		FExhibitionCameraEffect Effect;
+		float Alpha = 0.f;
+		float Weight = 0.f;
+		bool bReleased = false;
+	};
+
+	FEntry* FindEntry(const FName Id);
+
+	const FEntry* FindEntry(const FName Id) const;
+
+	TArray<FEntry, TFixedAllocator<Capacity>> Entries;
+
+	// Material blendables of the last Apply, kept across frames
+	TArray<FWeightedBlendable, TFixedAllocator<Capacity>> BlendableSlots;
+};
@@ -4,11 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "Camera/PlayerCameraManager.h"
+#include "Camera/ExhibitionCameraEffectStack.h"
+#include "Data/ExhibitionBakedCurve.h"
 #include "ExhibitionCameraManager.generated.h"
 
 class AExhibitionCharacter;
 class UExhibitionMovementComponent;
 class UCameraShakeBase;
+struct FStreamableHandle;
 
 /**
  * 
@@ -19,24 +22,70 @@ class MOVEMENTEXHIBITION_API AExhibitionCameraManager : public APlayerCameraMana
 	GENERATED_BODY()
 
 protected:
-	void Setup();
+	// Follows the movement events of Character, unbinding from the previous one
+	void Setup(AExhibitionCharacter* Character);
+
+	void BindMovementEvents();
+
+	void UnbindMovementEvents();
+
+	// Reads the movement state once after binding, events keep it up to date afterwards
+	void SyncMovementState();
 	
 	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
 
 	void ComputeCrouch(FTViewTarget& OutVT, float DeltaTime);
 	
-	void ComputeHook(FTViewTarget& OutVT, float DeltaTime);
-	
-	void ComputeRope(FTViewTarget& OutVT, float DeltaTime);
+	// Blends the pushed effects and applies them to the view
+	void ComputeEffects(FTViewTarget& OutVT, float DeltaTime);
 
-	void ComputeFOV(FTViewTarget& OutVT, float DeltaTime);
+	void SetEffectActive(const FName Id, const bool bActive, const FExhibitionCameraEffect& Effect);
+
+	FExhibitionCameraEffect MakeCrouchEffect() const;
+
+	FExhibitionCameraEffect MakeHookEffect() const;
+
+	FExhibitionCameraEffect MakeRopeEffect() const;
 	
-	void HandleCameraShake(float DeltaTime);
+	// Swaps the shake when the locomotion state changed
+	void UpdateCameraShake();
+
+	UFUNCTION()
+	void HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
+	UFUNCTION()
+	void HandleMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode);
+
+	UFUNCTION()
+	void HandleLocomotionChanged();
+
+	UFUNCTION()
+	void HandleStartCrouch();
+
+	UFUNCTION()
+	void HandleEndCrouch();
+
+	UFUNCTION()
+	void HandleEnterHook();
+
+	UFUNCTION()
+	void HandleExitHook();
+
+	UFUNCTION()
+	void HandleEnterRope();
 
-	static void ToggleCustomBlur(FTViewTarget& OutVT, const float BlurAmountOffset, const float BlurDistortionOffset, const bool bAdd);
-	static void TogglePostProcessMaterial(FTViewTarget& OutVT, UMaterialInstance* Material, const bool bAdd);
+	UFUNCTION()
+	void HandleExitRope();
 
-	float CalculateFov(const float Delta, const float MaxDuration, const float Target, const FRuntimeFloatCurve& Curve);
+	void BakeCurves();
+
+	// Requests every soft camera asset, the per-frame path only reads the hard references filled on completion
+	void PreloadAssets();
+
+	void OnAssetsLoaded();
+
+	// Loaded Material, reports the frame when Asset is set but not resident yet
+	UMaterialInstance* GetResidentMaterial(const TSoftObjectPtr<UMaterialInstance>& Asset, UMaterialInstance* Material) const;
 
 public:
 	virtual void InitializeFor(APlayerController* PC) override;
@@ -49,6 +98,9 @@ protected:
 	UPROPERTY(Transient)
 	float CrouchLocationTime = 0.f;
 
+	// Curve value at CrouchLocationTime, only evaluated while the time moves
+	float CrouchLocationRatio = 0.f;
+
 	UPROPERTY(EditDefaultsOnly, Category="Crouch")
 	float CrouchOffsetFOV = 15.f;
 
@@ -82,6 +134,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="Rope")
 	TSoftObjectPtr<UMaterialInstance> RopeSpeedLines;
 	
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstance> HookSpeedLinesMaterial;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstance> RopeSpeedLinesMaterial;
+
+	TSharedPtr<FStreamableHandle> AssetsHandle;
+
 	UPROPERTY(EditDefaultsOnly, Category="Rope")
 	float RopeOffsetFOV = 15.f;
 
@@ -91,6 +151,11 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="Rope")
 	FRuntimeFloatCurve RopeFOVCurve;
 
+	// Curves sampled when the manager is initialized
+	FExhibitionBakedCurve BakedCrouchLocationCurve;
+	FExhibitionBakedCurve BakedCrouchFOVCurve;
+	FExhibitionBakedCurve BakedRopeFOVCurve;
+
 	UPROPERTY(EditDefaultsOnly, Category="Camera Shake")
 	TSubclassOf<UCameraShakeBase> IdleCameraShake;
 
@@ -100,8 +165,24 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="Camera Shake")
 	TSubclassOf<UCameraShakeBase> SprintCameraShake;
 
+	FExhibitionCameraEffectStack EffectStack;
+
+	enum class EShakeState : uint8
+	{
+		None,
+		Idle,
+		Walk,
+		Sprint,
+	};
+
+	EShakeState ShakeState = EShakeState::None;
+
 	UPROPERTY(Transient)
-	float CurrentFOVTime = 0.f;
+	TObjectPtr<UCameraShakeBase> ActiveCameraShake;
+
+	// Movement state, updated from the movement events
+	bool bCrouching = false;
+	bool bHooking = false;
 
 	UPROPERTY(Transient)
 	TObjectPtr<AExhibitionCharacter> CharacterRef;
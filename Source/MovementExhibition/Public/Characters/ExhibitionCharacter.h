@@ -9,6 +9,7 @@
 class UCameraComponent;
 class USpringArmComponent;
 class UExhibitionMovementComponent;
+class UExhibitionHookLineComponent;
 
 UCLASS()
 class MOVEMENTEXHIBITION_API AExhibitionCharacter : public ACharacter
@@ -53,4 +54,7 @@ protected:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	TObjectPtr<UExhibitionMovementComponent> ExhibitionMovementComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+	TObjectPtr<UExhibitionHookLineComponent> HookLine;
 };
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ExhibitionHookReachabilityCommandlet.generated.h"
+
+/**
+ * Voxelizes the space around a level's hooks and bakes, for every cell the capsule fits in, the tagged hooks within range
+ * of any point of the cell and with a clear capsule line of sight from at least one free spot of it. The lists err on the
+ * side of too many hooks, the runtime sweeps its pick again. Cells are grown when the grid would exceed MaxCells.
+ *
+ * UnrealEditor-Cmd.exe MovementExhibition.uproject -run=ExhibitionHookReachability
+ *     -Map=/Game/Game/Levels/L_Playground -Tag=Hook [-CellSize=200] [-MaxDistance=5000] [-Radius=34] [-HalfHeight=88] [-MaxCells=16777216]
+ */
+UCLASS()
+class MOVEMENTEXHIBITION_API UExhibitionHookReachabilityCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UExhibitionHookReachabilityCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
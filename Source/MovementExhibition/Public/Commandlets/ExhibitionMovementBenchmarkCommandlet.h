@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ExhibitionMovementBenchmarkCommandlet.generated.h"
+
+/**
+ * Spawns characters in a level, drives them with scripted input timelines and measures the cost of every movement tick,
+ * grouped by the movement mode the tick started in. Writes mean, p50 and p99 per mode to a JSON report.
+ * The world itself is not ticked: characters using async hook resolution never see their sweeps complete.
+ *
+ * UnrealEditor-Cmd.exe MovementExhibition.uproject -run=ExhibitionMovementBenchmark -nullrhi
+ *     -Map=/Game/Game/Levels/L_Playground [-Character=/Game/Game/Blueprints/Characters/BP_ExhibitionCharacter.BP_ExhibitionCharacter_C]
+ *     [-Scenario=All|SprintSlide|HookChain|RopeJump|DiveDodge] [-Count=32] [-Frames=1800] [-DeltaTime=0.0166] [-Output=<File.json>]
+ */
+UCLASS()
+class MOVEMENTEXHIBITION_API UExhibitionMovementBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UExhibitionMovementBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineMeshComponent.h"
+#include "ExhibitionHookLineComponent.generated.h"
+
+/**
+ * Hook cable drawn as a single spline mesh segment between two world locations.
+ * The shape is computed analytically, straight or sagging like a catenary, with no particle simulation.
+ * Meant to be driven by the movement component while hooking; the mesh should be modeled along the forward axis.
+ */
+UCLASS(ClassGroup=Rendering, meta=(BlueprintSpawnableComponent))
+class MOVEMENTEXHIBITION_API UExhibitionHookLineComponent : public USplineMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UExhibitionHookLineComponent();
+
+	void ShowLine();
+
+	void HideLine();
+
+	// Start and End in world space
+	void UpdateLine(const FVector& Start, const FVector& End);
+
+	// Depth of the middle of the line below the chord, for a cable Slack times longer than the distance it spans
+	static float ComputeSag(const float Span, const float Slack);
+
+public:
+	// Extra cable length over the spanned distance. 0 draws a straight line.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hook Line", meta=(ClampMin=0.f))
+	float Slack = 0.f;
+};
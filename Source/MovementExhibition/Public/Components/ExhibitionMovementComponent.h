@@ -4,11 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/ExhibitionMovementEvents.h"
+#include "Data/ExhibitionBakedCurve.h"
+#include "Subsystems/ExhibitionHookSubsystem.h"
+#include "Subsystems/ExhibitionRopeSubsystem.h"
 #include "ExhibitionMovementComponent.generated.h"
 
 class AExhibitionCharacter;
 class UAnimMontage;
 class UCableComponent;
+class UExhibitionHookLineComponent;
+class UExhibitionNetUpdatePolicy;
 
 UENUM(BlueprintType)
 enum ECustomMovementMode
@@ -54,6 +60,15 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnExitHookDelegate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnterRopeDelegate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnExitRopeDelegate);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStartSprintDelegate);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStopSprintDelegate);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStartWalkDelegate);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStopWalkDelegate);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStartCrouchDelegate);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEndCrouchDelegate);
+
 /**
  * 
  */
@@ -70,10 +85,11 @@ class MOVEMENTEXHIBITION_API UExhibitionMovementComponent : public UCharacterMov
 		FSavedMove_Exhibition();
 
 		virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+		virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
 		virtual void Clear() override;
-		virtual uint8 GetCompressedFlags() const override;
 		virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
 		virtual void PrepMoveFor(ACharacter* C) override;
+		virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override;
 		
 		// Flags
 		uint8 Saved_bWantsToSprint:1 = false;
@@ -85,6 +101,23 @@ class MOVEMENTEXHIBITION_API UExhibitionMovementComponent : public UCharacterMov
 		uint8 Saved_bPrevWantsToCrouch:1 = false;
 		uint8 Saved_bReachedDestination:1 = false;
 		int32 Saved_FlyingDiveCount = 0;
+
+		// Hook or rope the move ended up travelling to
+		TWeakObjectPtr<AActor> Saved_Target;
+
+		// Combining
+		uint8 Saved_bSliding:1 = false;
+		// Hook or rope travel driven by root motion only, safe to merge with the next steady move
+		uint8 Saved_bSteadyTravel:1 = false;
+		FName Saved_TravelName;
+		FVector Saved_TravelDestination = FVector::ZeroVector;
+		float Saved_TravelTolerance = 0.f;
+
+	protected:
+		// Replaying both moves as one must land within the combine tolerance of where they are expected to end
+		bool IsCombinedMoveWithinTolerance(const FSavedMove_Exhibition& NewMove) const;
+
+		bool HasSameRootMotionSources(const FSavedMove_Exhibition& NewMove) const;
 	};
 
 	class FNetworkPredictionData_Client_Exhibition : public FNetworkPredictionData_Client_Character
@@ -97,12 +130,50 @@ class MOVEMENTEXHIBITION_API UExhibitionMovementComponent : public UCharacterMov
 		virtual FSavedMovePtr AllocateNewMove() override;
 	};
 
+	// Exhibition state sent with every ServerMove, bit-packed instead of borrowing compressed flags
+	class FNetworkMoveData_Exhibition : public FCharacterNetworkMoveData
+	{
+	public:
+		using Super = FCharacterNetworkMoveData;
+
+		enum EExhibitionFlags : uint8
+		{
+			FLAG_WantsToSprint			= 0x01,
+			FLAG_WantsToDive			= 0x02,
+			FLAG_WantsToHook			= 0x04,
+			FLAG_CustomPressedJump		= 0x08,
+			FLAG_PrevWantsToCrouch		= 0x10,
+			FLAG_ReachedDestination		= 0x20,
+			// Flying dive count, clamped to 3, in the top two bits
+			FLAG_FlyingDiveCountShift	= 6,
+		};
+
+		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+		FORCEINLINE bool HasFlag(const EExhibitionFlags Flag) const { return (ExhibitionFlags & Flag) != 0; }
+		FORCEINLINE int32 GetFlyingDiveCount() const { return ExhibitionFlags >> FLAG_FlyingDiveCountShift; }
+
+		uint8 ExhibitionFlags = 0;
+		AActor* Target = nullptr;
+	};
+
+	class FNetworkMoveDataContainer_Exhibition : public FCharacterNetworkMoveDataContainer
+	{
+	public:
+		FNetworkMoveDataContainer_Exhibition();
+
+		FNetworkMoveData_Exhibition MoveData[3];
+	};
+
 // CMC Specific
 public:
 	UExhibitionMovementComponent();
 
 	virtual void InitializeComponent() override;
 
+	virtual void BeginPlay() override;
+
 	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 
 	virtual float GetMaxSpeed() const override;
@@ -124,7 +195,7 @@ public:
 	virtual bool DoJump(bool bReplayingMoves) override;
 
 protected:
-	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
 
 	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
 
@@ -143,6 +214,9 @@ protected:
 
 	float GetCapsuleHalfHeight() const;
 
+	// Finds the owner's hook line or cable once
+	void BindHookCable();
+
 	void ToggleHookCable();
 
 	void UpdateHookCable(const float DeltaTime);
@@ -159,19 +233,55 @@ protected:
 	void FinishSlide();
 
 	bool CanSlide() const;
+
+	// Whether there is ground within reach below the capsule, answered by CurrentFloor when it is fresh
+	bool HasSlideSurface() const;
+
+	// CurrentFloor was computed at the current location
+	bool IsCurrentFloorFresh() const;
 	
 	void PhysSlide(float deltaTime, int32 Iterations);
 
 	// Diving
-	void PerformDive();
+	EExhibitionDiveType PerformDive();
 
 	bool CanDive() const;
 
 	// Hooking
 	bool TryHook();
 
+	bool TryHookAsync();
+
+	// Runs the hook search this move is allowed to run, synchronous or asynchronous
+	bool TrySearchHook();
+
+	// Confirms the hook this move carries, O(1) instead of a full search.
+	// That is the owning client's pick on the server, and the recorded pick when the client replays the move.
+	bool TryClientHook();
+
+	AActor* ResolvePendingHookSearch(bool& bExpired);
+
+	// Fills HookShortlist with the page of candidates starting at FirstCandidate, best ranked first
+	void ScoreHookCandidates(const UExhibitionHookSubsystem& HookSubsystem, const int32 FirstCandidate);
+
+	void ResetPendingHookSearch();
+
+	bool CommitHook(AActor* SelectedHook);
+
 	bool CanUseHook(const AActor* Hook, float& DistSqr, float& DotResult, bool& bIsBlocked) const;
 
+	bool IsHookInRange(const AActor* Hook, float& DistSqr, float& DotResult) const;
+
+	bool IsHookBlocked(const AActor* Hook) const;
+
+	FCollisionQueryParams GetHookQueryParams(const AActor* Hook) const;
+
+	bool FindCachedHookVisibility(const AActor* Hook, bool& bIsBlocked) const;
+
+	void CacheHookVisibility(const AActor* Hook, const FVector& CharacterLocation, const bool bIsBlocked) const;
+
+	static uint32 GetHookCollisionSignature(const AActor* Hook);
+
 	void EnterHook();
 
 	void FinishHook();
@@ -183,7 +293,8 @@ protected:
 
 	void FinishRope();
 
-	static void GetRopePositions(const UCableComponent* Rope, FVector& StartPosition, FVector& EndPosition);
+	// Tests the jump parabola against the registered ropes, the earliest hit whose arc is clear of static geometry wins
+	bool FindRopeOnJumpArc(const FVector& Start, const FVector& LaunchVelocity, FVector& OutLocation, FExhibitionRopeSegment& OutRope);
 	
 	// Travel to destination
 	void PhysTravel(float deltaTime, int32 Iterations);
@@ -245,16 +356,27 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	UFUNCTION()
-	void OnRep_Dive();
+	void OnRep_Events();
 
-	UFUNCTION()
-	void OnRep_JumpExtra();
+protected:
+	// Server only, raises a cosmetic event for simulated proxies
+	void PushProxyEvent(const FExhibitionMovementEvent& Event);
 
-	UFUNCTION()
-	void OnRep_FindHook();
+	void ReplayProxyEvent(const FExhibitionMovementEvent& Event);
 
-	UFUNCTION()
-	void OnRep_FindRope();
+	void ApplyHookTarget(AActor* Hook, const FVector& Destination);
+
+	void ApplyRopeTarget(const FVector& Destination, const FVector& Normal);
+
+	// Hook or rope travel with nothing but the travel root motion running, launches and montages excluded
+	bool IsInSteadyTravel() const;
+
+	// Raises the sprint, walk and crouch delegates when their state changed since the last call
+	void BroadcastLocomotionChanges();
+
+	// Server: sets the owner's update rates from NetUpdatePolicy.
+	// Rates are re-evaluated every policy interval, bForce applies them right away.
+	void UpdateNetUpdateFrequency(const float DeltaSeconds, const bool bForce);
 
 // CMC Safe Properties
 protected:
@@ -266,27 +388,35 @@ protected:
 
 	bool Safe_bWantsToHook = false;
 
-	uint16 CurrentTransitionId;
+	uint16 CurrentTransitionId = 0;
 
 // FSavedMove properties
 protected:
 	int32 Safe_FlyingDiveCount = 0;
 
 	bool Safe_bReachedDestination = false;
+
+	// Travel target picked by the move being performed: sent by the owning client to the server,
+	// restored from the saved move on client replays. Cleared once the move state is updated.
+	TWeakObjectPtr<AActor> Safe_ClientTarget;
+
+	FNetworkMoveDataContainer_Exhibition MoveDataContainer;
 	
 // Replication properties
 protected:
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_Dive)
-	bool Proxy_Dive = false;
-	
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_JumpExtra)
-	bool Proxy_JumpExtra = false;
+	// Dive, extra jump, hook and rope events in a single property
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_Events)
+	FExhibitionMovementEventHistory Proxy_Events;
 
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_FindHook)
-	bool Proxy_FindHook = false;
+	uint8 LastReplayedEventSequence = 0;
 
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_FindRope)
-	bool Proxy_FindRope = false;
+	// Owner's update rates per movement mode. None keeps the character's own rates.
+	UPROPERTY(EditAnywhere, Instanced, Category="Exhibition|Replication")
+	TObjectPtr<UExhibitionNetUpdatePolicy> NetUpdatePolicy;
+
+	float NetUpdatePolicyTimer = 0.f;
+
+	float IdleTime = 0.f;
 	
 // Standard Properties
 protected:
@@ -311,6 +441,16 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Exhibition|Slide")
 	float SlideBrakingDeceleration = 1000.f;
 
+	// Surface trace of the last slide check, reused within the frame while the character has not moved
+	struct FSlideSurfaceCache
+	{
+		uint64 Frame = 0;
+		FVector Location = FVector::ZeroVector;
+		bool bValidSurface = false;
+	};
+
+	mutable FSlideSurfaceCache SlideSurfaceCache;
+
 	UPROPERTY(EditAnywhere, Category="Exhibition|Dive")
 	float DiveImpulse = 1000.f;
 
@@ -343,6 +483,14 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category="Exhibition|Hook")
 	float IgnoreHookDistance = 100.f;
+
+	// Minimum dot product between the character forward and the direction to the hook (2D)
+	UPROPERTY(EditAnywhere, Category="Exhibition|Hook", meta=(ClampMin=-1.f, ClampMax=1.f))
+	float HookFieldOfViewDot = 0.8f;
+
+	// How many of the best scored hooks get a line of sight sweep
+	UPROPERTY(EditAnywhere, Category="Exhibition|Hook", meta=(ClampMin=1))
+	int32 HookShortlistSize = 4;
 	
 	UPROPERTY(EditAnywhere, Category="Exhibition|Hook")
 	float MaxHookSpeed = 600.f;
@@ -356,6 +504,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Exhibition|Hook")
 	TObjectPtr<UCurveFloat> HookCurve;
 
+	// Hook sweeps are reused while the character stays within this distance of where they were made. 0 disables the cache.
+	UPROPERTY(EditAnywhere, Category="Exhibition|Hook", meta=(ClampMin=0.f))
+	float HookVisibilityCacheDistance = 50.f;
+
+	// Hook line of sight sweeps are issued asynchronously and resolved on the next frame
+	UPROPERTY(EditAnywhere, Category="Exhibition|Hook")
+	bool bAsyncHookResolution = false;
+
 	UPROPERTY(EditAnywhere, Category="Exhibition|Hook")
 	bool bHandleCable = true;
 
@@ -370,10 +526,52 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category="Exhibition|Hook", meta=(EditCondition=bHandleCable))
 	FRuntimeFloatCurve CableCurve;
+
+	// CableCurve sampled when the component is initialized
+	FExhibitionBakedCurve BakedCableCurve;
+
+	// Hook visuals of the owner, the analytic line is used over the simulated cable when both exist
+	UPROPERTY(Transient)
+	TObjectPtr<UExhibitionHookLineComponent> HookLine;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UCableComponent> HookCable;
 	
 	UPROPERTY(Transient)
 	TObjectPtr<AActor> CurrentHook;
 
+	// Reused by TryHook, only valid while a search is running.
+	// Holds one page of HookShortlistSize candidates, the next page is scored when every hook of this one is blocked.
+	TArray<FExhibitionHookScore> HookShortlist;
+
+	struct FPendingHookSearch
+	{
+		// Best ranked first
+		TArray<TWeakObjectPtr<AActor>> Hooks;
+		// Filled from the visibility cache, otherwise from the trace result
+		TArray<bool> bIsBlocked;
+		// Invalid when the visibility was cached
+		TArray<FTraceHandle> Handles;
+		uint64 IssuedFrame = 0;
+		// Rank of the first hook of the page being traced
+		int32 FirstCandidate = 0;
+
+		FORCEINLINE bool IsPending() const { return !Handles.IsEmpty(); }
+	};
+
+	FPendingHookSearch PendingHookSearch;
+
+	struct FHookVisibility
+	{
+		FVector CharacterLocation = FVector::ZeroVector;
+		FVector HookLocation = FVector::ZeroVector;
+		uint32 CollisionSignature = 0;
+		bool bIsBlocked = false;
+	};
+
+	// Last sweep result per hook, reused while neither the character nor the hook moved
+	mutable TMap<TWeakObjectPtr<const AActor>, FHookVisibility> HookVisibilityCache;
+
 	UPROPERTY(EditAnywhere, Category="Exhibition|Rope")
 	FName TagRopeName = NAME_None;
 	
@@ -404,6 +602,12 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Exhibition|Rope")
 	TObjectPtr<UCurveFloat> RopeSpeedCurve;
 
+	// Reused by TryRope, only valid while a search is running
+	TArray<FExhibitionRopeSegment> RopeCandidates;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> CurrentRope;
+
 	TOptional<FTravelData> TravelData;
 	
 	// TODO Probably not the ideal solution
@@ -416,8 +620,13 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<AExhibitionCharacter> ExhibitionCharacterRef;
 
+	// Last locomotion state raised through the delegates
+	bool bBroadcastSprinting = false;
+	bool bBroadcastWalking = false;
+	bool bBroadcastCrouching = false;
+
 // Delegates
-protected:
+public:
 	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
 	FOnEnterSlideDelegate OnEnterSlide;
 
@@ -439,6 +648,25 @@ protected:
 	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
 	FOnExitRopeDelegate OnExitRope;
 
+	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
+	FOnStartSprintDelegate OnStartSprint;
+
+	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
+	FOnStopSprintDelegate OnStopSprint;
+
+	// Moving on the ground
+	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
+	FOnStartWalkDelegate OnStartWalk;
+
+	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
+	FOnStopWalkDelegate OnStopWalk;
+
+	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
+	FOnStartCrouchDelegate OnStartCrouch;
+
+	UPROPERTY(BlueprintAssignable, Category="Exhibition Events")
+	FOnEndCrouchDelegate OnEndCrouch;
+
 // Constants
 public:
 	static const FString HOOK_TRAVEL_NAME;
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "ExhibitionMovementEvents.generated.h"
+
+UENUM()
+enum class EExhibitionMovementEvent : uint8
+{
+	Dive,
+	JumpExtra,
+	Hook,
+	Rope,
+};
+
+enum class EExhibitionDiveType : uint8
+{
+	Dive,
+	FlyingDive,
+	DodgeBack,
+};
+
+// Cosmetic event raised by the server and replayed by simulated proxies
+USTRUCT()
+struct FExhibitionMovementEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EExhibitionMovementEvent Type = EExhibitionMovementEvent::Dive;
+
+	// Dive: EExhibitionDiveType
+	UPROPERTY()
+	uint8 Variant = 0;
+
+	// Hook: target and destination
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Target;
+
+	// Hook and rope: travel destination
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	// Rope: travel direction
+	UPROPERTY()
+	FVector_NetQuantizeNormal Normal = FVector::ZeroVector;
+};
+
+/**
+ * The last few movement events, oldest first, behind a rolling sequence.
+ * Proxies compare the sequence with the last one they replayed to find the events they missed,
+ * so several events inside one net update are never merged.
+ * NetSerialize packs it for the legacy replication path, Iris builds its serializer from the properties
+ * (see SupportsStructNetSerializerList in DefaultEngine.ini).
+ */
+USTRUCT()
+struct MOVEMENTEXHIBITION_API FExhibitionMovementEventHistory
+{
+	GENERATED_BODY()
+
+	static constexpr int32 Capacity = 4;
+
+	void Push(const FExhibitionMovementEvent& Event);
+
+	// Events raised after LastSequence that are still in the history, oldest first
+	int32 GetMissedEvents(const uint8 LastSequence, TArray<const FExhibitionMovementEvent*, TInlineAllocator<Capacity>>& OutEvents) const;
+
+	FORCEINLINE uint8 GetSequence() const { return Sequence; }
+
+	FORCEINLINE const FExhibitionMovementEvent* GetLatest() const { return Events.IsEmpty()? nullptr : &Events.Last(); }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Every push bumps the sequence, comparing it is enough
+	FORCEINLINE bool operator==(const FExhibitionMovementEventHistory& Other) const { return Sequence == Other.Sequence; }
+
+private:
+	UPROPERTY()
+	uint8 Sequence = 0;
+
+	UPROPERTY()
+	TArray<FExhibitionMovementEvent> Events;
+};
+
+template<>
+struct TStructOpsTypeTraits<FExhibitionMovementEventHistory> : public TStructOpsTypeTraitsBase2<FExhibitionMovementEventHistory>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/Object.h"
+#include "ExhibitionNetUpdatePolicy.generated.h"
+
+USTRUCT(BlueprintType)
+struct FExhibitionNetUpdateRate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0.1f))
+	float NetUpdateFrequency = 30.f;
+
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0.1f))
+	float MinNetUpdateFrequency = 10.f;
+
+	// Speed at which NetUpdateFrequency is reached, slower characters scale down towards MinNetUpdateFrequency.
+	// 0 always uses NetUpdateFrequency.
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0.f))
+	float FullRateSpeed = 0.f;
+};
+
+/**
+ * Picks the owner's net update frequencies from its movement mode, speed and idle time.
+ * Evaluated by the server only.
+ */
+UCLASS(EditInlineNew, DefaultToInstanced, CollapseCategories, BlueprintType)
+class MOVEMENTEXHIBITION_API UExhibitionNetUpdatePolicy : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UExhibitionNetUpdatePolicy();
+
+	const FExhibitionNetUpdateRate& GetRate(const EMovementMode MovementMode, const uint8 CustomMovementMode, const bool bIdle) const;
+
+	void ComputeFrequencies(const EMovementMode MovementMode, const uint8 CustomMovementMode, const float Speed, const bool bIdle, float& OutNetUpdateFrequency, float& OutMinNetUpdateFrequency) const;
+
+	FORCEINLINE float GetIdleSpeed() const { return IdleSpeed; }
+	FORCEINLINE float GetIdleDelay() const { return IdleDelay; }
+	FORCEINLINE float GetEvaluationInterval() const { return EvaluationInterval; }
+
+protected:
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Idle;
+
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Walking;
+
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Falling;
+
+	// Flying dives
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Dive;
+
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Slide;
+
+	// Proxies integrate the travel on their own
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Hook;
+
+	UPROPERTY(EditAnywhere, Category="Net Update Policy")
+	FExhibitionNetUpdateRate Rope;
+
+	// Below this speed, without input, for IdleDelay seconds, the character is idle
+	UPROPERTY(EditAnywhere, Category="Net Update Policy", meta=(ClampMin=0.f))
+	float IdleSpeed = 10.f;
+
+	UPROPERTY(EditAnywhere, Category="Net Update Policy", meta=(ClampMin=0.f))
+	float IdleDelay = 1.f;
+
+	// Seconds between two evaluations, mode changes are always applied immediately
+	UPROPERTY(EditAnywhere, Category="Net Update Policy", meta=(ClampMin=0.f))
+	float EvaluationInterval = 0.25f;
+};
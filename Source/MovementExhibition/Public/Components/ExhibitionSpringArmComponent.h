@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "ExhibitionSpringArmComponent.generated.h"
+
+/**
+ * Spring arm whose collision probe runs asynchronously.
+ * The last probe is reused, as a fraction of the arm, while the arm moves less than ProbeReuseTolerance. Past that a
+ * probe is issued for the next frame, and past SyncProbeDistance the arm probes right away.
+ */
+UCLASS(ClassGroup=Camera, meta=(BlueprintSpawnableComponent))
+class MOVEMENTEXHIBITION_API UExhibitionSpringArmComponent : public USpringArmComponent
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+	// Reads the async probe issued during a previous frame, if any
+	void CollectPendingProbe();
+
+	void ProbeNow(const FVector& ArmOrigin, const FVector& DesiredLocation);
+
+	void RequestProbe(const FVector& ArmOrigin, const FVector& DesiredLocation);
+
+	void ResetProbes();
+
+	FCollisionQueryParams GetProbeQueryParams() const;
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Camera Collision")
+	bool bAsyncProbe = true;
+
+	// Arm motion since the last probe under which its result is reused as is
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Camera Collision", meta=(ClampMin=0.f, EditCondition=bAsyncProbe))
+	float ProbeReuseTolerance = 10.f;
+
+	// Arm motion since the last probe over which the arm probes synchronously, e.g. teleports or hook launches
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Camera Collision", meta=(ClampMin=0.f, EditCondition=bAsyncProbe))
+	float SyncProbeDistance = 300.f;
+
+protected:
+	struct FProbe
+	{
+		FVector Origin = FVector::ZeroVector;
+		FVector Desired = FVector::ZeroVector;
+		// Fraction of the arm before the blocking hit
+		float HitTime = 1.f;
+		bool bBlockingHit = false;
+	};
+
+	FProbe LastProbe;
+
+	bool bHasProbe = false;
+
+	FTraceHandle PendingProbe;
+
+	uint64 PendingProbeFrame = 0;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Benchmark/ExhibitionBenchmark.h"
 #include "GameFramework/PlayerController.h"
 #include "ExhibitionPlayerController.generated.h"
 
@@ -19,6 +20,9 @@ class MOVEMENTEXHIBITION_API AExhibitionPlayerController : public APlayerControl
 {
 	GENERATED_BODY()
 
+public:
+	virtual void PlayerTick(float DeltaTime) override;
+
 protected:
 	virtual void AcknowledgePossession(APawn* P) override;
 	
@@ -27,6 +31,9 @@ protected:
 	virtual void SetupInputComponent() override;
 
 	virtual void InitializeMappingContext();
+
+	// Networked benchmark clients: -BenchmarkScenario=<Name|All> drives the possessed character with a scripted timeline
+	void StartBenchmarkInput();
 	
 public:
 	void RequestMove(const FInputActionValue& InputAction);
@@ -81,4 +88,6 @@ protected:
 	
 	UPROPERTY(Transient)
 	TObjectPtr<AExhibitionCharacter> CharacterRef;
+
+	TOptional<ExhibitionBenchmark::FScenarioPlayer> BenchmarkInput;
 };
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FRichCurve;
+struct FRuntimeFloatCurve;
+
+/**
+ * Float curve sampled at a fixed resolution over its key range, evaluated with a single lerp.
+ * Times outside of the key range are clamped, like a curve with constant extrapolation.
+ */
+struct MOVEMENTEXHIBITION_API FExhibitionBakedCurve
+{
+	static constexpr int32 DefaultResolution = 128;
+
+	void Bake(const FRichCurve& Curve, const int32 Resolution = DefaultResolution, const TCHAR* DebugName = nullptr);
+
+	void Bake(const FRuntimeFloatCurve& Curve, const int32 Resolution = DefaultResolution, const TCHAR* DebugName = nullptr);
+
+	void Reset();
+
+	FORCEINLINE bool IsBaked() const { return Samples.Num() >= 2; }
+
+	FORCEINLINE float Eval(const float Time) const
+	{
+		if (!IsBaked())
+		{
+			return 0.f;
+		}
+
+		const float Position = FMath::Clamp((Time - MinTime) * InvStep, 0.f, static_cast<float>(Samples.Num() - 1));
+		const int32 Index = FMath::Min(static_cast<int32>(Position), Samples.Num() - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+	}
+
+	// Same as Eval for each time, four at a time. OutValues must be as large as Times.
+	void EvalBatch(TConstArrayView<float> Times, TArrayView<float> OutValues) const;
+
+	// Largest difference with Curve, sampled SamplesPerStep times between two baked samples
+	float MeasureMaxError(const FRichCurve& Curve, const int32 SamplesPerStep = 8, float* OutWorstTime = nullptr) const;
+
+private:
+	TArray<float> Samples;
+
+	float MinTime = 0.f;
+
+	float InvStep = 0.f;
+};
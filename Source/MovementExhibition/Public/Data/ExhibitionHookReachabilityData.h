@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ExhibitionHookReachabilityData.generated.h"
+
+/**
+ * Baked hook visibility for a level, generated by UExhibitionHookReachabilityCommandlet.
+ * The space around the hooks is split in cells, each one listing the tagged hooks within range and with a clear capsule
+ * line of sight from a free spot of the cell. Cells without any free spot carry no data.
+ */
+UCLASS()
+class MOVEMENTEXHIBITION_API UExhibitionHookReachabilityData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Hooks reachable from the cell containing Location, as indices into HookNames.
+	// False outside of the baked volume and for cells that carry no data.
+	bool GetCellHooks(const FVector& Location, TConstArrayView<uint16>& OutHooks) const;
+
+	int32 GetCellIndex(const FVector& Location) const;
+
+	FORCEINLINE int64 GetNumCells() const { return int64(Dimensions.X) * int64(Dimensions.Y) * int64(Dimensions.Z); }
+
+	// Bake sweeps only hold for capsules at least as large as the baked one
+	bool IsCompatibleCapsule(const float Radius, const float HalfHeight) const;
+
+	FVector GetCellCenter(const int32 CellIndex) const;
+
+	// Where the baked data of the world saved in WorldPackageName lives
+	static FString GetPackageNameForWorld(const FString& WorldPackageName);
+
+	static FString GetAssetNameForWorld(const FString& WorldPackageName);
+
+public:
+	UPROPERTY(VisibleAnywhere, Category="Bake")
+	FName HookTag = NAME_None;
+
+	UPROPERTY(VisibleAnywhere, Category="Bake")
+	float MaxHookDistance = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category="Bake")
+	float CapsuleRadius = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category="Bake")
+	float CapsuleHalfHeight = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category="Grid")
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category="Grid")
+	float CellSize = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category="Grid")
+	FIntVector Dimensions = FIntVector::ZeroValue;
+
+	// Names of the hook actors in the level, baked indices refer to this list
+	UPROPERTY(VisibleAnywhere, Category="Hooks")
+	TArray<FName> HookNames;
+
+	// Hooks of cell N are CellHooks[CellStarts[N], CellStarts[N + 1])
+	UPROPERTY()
+	TArray<int32> CellStarts;
+
+	UPROPERTY()
+	TArray<uint16> CellHooks;
+
+	// False for cells the capsule could not fit in, lookups there fall back to the hook grid
+	UPROPERTY()
+	TArray<bool> BakedCells;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// stat ExhibitionMovement
+DECLARE_STATS_GROUP(TEXT("ExhibitionMovement"), STATGROUP_ExhibitionMovement, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryHook"), STAT_ExhibitionMovement_TryHook, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryHookAsync"), STAT_ExhibitionMovement_TryHookAsync, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CanUseHook"), STAT_ExhibitionMovement_CanUseHook, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IsHookBlocked"), STAT_ExhibitionMovement_IsHookBlocked, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ScoreHooks"), STAT_ExhibitionMovement_ScoreHooks, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateHookCable"), STAT_ExhibitionMovement_UpdateHookCable, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryRope"), STAT_ExhibitionMovement_TryRope, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("QueryRopes"), STAT_ExhibitionMovement_QueryRopes, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CanSlide"), STAT_ExhibitionMovement_CanSlide, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysSlide"), STAT_ExhibitionMovement_PhysSlide, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysTravel"), STAT_ExhibitionMovement_PhysTravel, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+
+// Counters are cleared every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_ExhibitionMovement_Traces, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hook Candidates"), STAT_ExhibitionMovement_HookCandidates, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rope Candidates"), STAT_ExhibitionMovement_RopeCandidates, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Camera Asset Misses"), STAT_ExhibitionMovement_CameraAssetMisses, STATGROUP_ExhibitionMovement, MOVEMENTEXHIBITION_API);
+
+// -csvCategories=ExhibitionMovement
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(MOVEMENTEXHIBITION_API, ExhibitionMovement);
+
+// -trace=cpu,ExhibitionMovement
+UE_TRACE_CHANNEL_EXTERN(ExhibitionMovementChannel, MOVEMENTEXHIBITION_API);
+
+// Times the enclosing scope in stat ExhibitionMovement, the CSV profiler and Insights at once
+#define EXHIBITION_MOVEMENT_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_ExhibitionMovement_##Name); \
+	CSV_SCOPED_TIMING_STAT(ExhibitionMovement, Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(ExhibitionMovement_##Name, ExhibitionMovementChannel)
+
+#define EXHIBITION_MOVEMENT_COUNT(Name, Amount) \
+	INC_DWORD_STAT_BY(STAT_ExhibitionMovement_##Name, Amount); \
+	CSV_CUSTOM_STAT(ExhibitionMovement, Name, int32(Amount), ECsvCustomStatOp::Accumulate)
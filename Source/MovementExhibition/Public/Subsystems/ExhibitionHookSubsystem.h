@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/ExhibitionSpatialGrid.h"
+#include "Subsystems/ExhibitionTaggedActorSubsystem.h"
+#include "ExhibitionHookSubsystem.generated.h"
+
+class UExhibitionHookReachabilityData;
+struct FCollisionShape;
+
+struct FExhibitionHookScore
+{
+	AActor* Hook = nullptr;
+	float DistSqr = 0.f;
+	float DotResult = 0.f;
+
+	// Hook ranking used by TryHook: the closest hook wins, the most centered one breaks ties
+	FORCEINLINE bool IsBetterThan(const FExhibitionHookScore& Other) const
+	{
+		return DistSqr < Other.DistSqr || (DistSqr == Other.DistSqr && DotResult > Other.DotResult);
+	}
+};
+
+/**
+ * Registry of every hook point in the world, fed by the tracked tags.
+ * Lookups only visit the grid cells around the query.
+ */
+UCLASS()
+class MOVEMENTEXHIBITION_API UExhibitionHookSubsystem : public UExhibitionTaggedActorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	UFUNCTION(BlueprintCallable)
+	void RegisterHook(AActor* Hook);
+
+	UFUNCTION(BlueprintCallable)
+	void UnregisterHook(AActor* Hook);
+
+	// Scores every hook around Origin in one vectorized pass: squared distance and the 2D dot product between
+	// LookDirection and the direction to the hook. Fills OutShortlist with at most MaxCandidates hooks
+	// within Radius and above MinDot, best ranked first, skipping the FirstCandidate best ranked ones.
+	// Returns true when the candidates came from the baked reachability data, in which case they were already
+	// visible from the cell containing Origin. Capsule is the shape the caller sweeps with, data baked for a larger one is skipped.
+	bool ScoreHooks(const FName& Tag, const FVector& Origin, const FVector& LookDirection, const FCollisionShape& Capsule, const float Radius, const float MinDot, const int32 FirstCandidate, const int32 MaxCandidates, TArray<FExhibitionHookScore>& OutShortlist) const;
+
+	FORCEINLINE int32 GetNumHooks() const { return Hooks.Num(); }
+
+protected:
+	virtual void RegisterTrackedActor(AActor* Actor) override;
+
+	virtual void UnregisterTrackedActor(AActor* Actor) override;
+
+	void OnHookTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	void SetHookLocation(const int32 Index, const FVector& Location);
+
+	void LoadReachabilityData();
+
+	void MapBakedHook(const AActor* Hook, const int32 Index);
+
+	// Fills QueryScratch from the baked cell around Origin. False when the bake cannot answer this query.
+	// Hooks spawned at runtime are not part of the bake.
+	bool GatherBakedCandidates(const FName& Tag, const FVector& Origin, const FCollisionShape& Capsule, const float Radius) const;
+
+	struct FHookEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+	};
+
+	TSparseArray<FHookEntry> Hooks;
+
+	TMap<TObjectKey<AActor>, int32> HookIndices;
+
+	// Structure-of-arrays copy of the hook locations, indexed like Hooks
+	TArray<double> HookX;
+	TArray<double> HookY;
+	TArray<double> HookZ;
+
+	TMap<TObjectKey<USceneComponent>, int32> MovableRoots;
+
+	FExhibitionSpatialGrid Grid;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UExhibitionHookReachabilityData> ReachabilityData;
+
+	// Baked hook index to registry index, INDEX_NONE while the hook is not registered
+	TArray<int32> BakedToRegistry;
+
+	TMap<FName, int32> BakedHookIndices;
+
+	mutable TArray<int32> QueryScratch;
+
+	// Origin-relative positions gathered for the scoring kernel, padded to the vector width
+	mutable TArray<float> ScoreX;
+	mutable TArray<float> ScoreY;
+	mutable TArray<float> ScoreZ;
+	mutable TArray<float> ScoreDistSqr;
+	mutable TArray<float> ScoreDot;
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExhibitionNetBenchmarkSubsystem.generated.h"
+
+/**
+ * Server side of the networked benchmark, only created with -NetBenchmark.
+ * Waits for the expected clients, lets the session warm up, then records the server game thread time and the bytes
+ * sent and received for a fixed duration. The report is written as JSON and the server exits.
+ *
+ * UnrealEditor.exe MovementExhibition.uproject L_Playground -server -nullrhi -NetBenchmark
+ *     [-BenchmarkClients=16] [-BenchmarkWarmup=10] [-BenchmarkDuration=60] [-BenchmarkOutput=<File.json>]
+ */
+UCLASS()
+class MOVEMENTEXHIBITION_API UExhibitionNetBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	int32 GetNumConnectedClients() const;
+
+	void StartCapture();
+
+	void FinishCapture();
+
+	enum class EPhase : uint8
+	{
+		Disabled,
+		WaitingForClients,
+		Warmup,
+		Capture,
+		Done,
+	};
+
+	EPhase Phase = EPhase::Disabled;
+
+	int32 ExpectedClients = 16;
+
+	float WarmupSeconds = 10.f;
+
+	float CaptureSeconds = 60.f;
+
+	FString OutputFile;
+
+	double PhaseStartTime = 0.0;
+
+	// Net driver totals when the capture started
+	uint32 StartOutBytes = 0;
+	uint32 StartInBytes = 0;
+	uint32 StartOutPackets = 0;
+
+	// Game thread time of every captured frame, in milliseconds
+	TArray<double> FrameSamples;
+};
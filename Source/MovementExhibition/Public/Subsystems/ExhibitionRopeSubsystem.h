@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/ExhibitionSpatialGrid.h"
+#include "Subsystems/ExhibitionTaggedActorSubsystem.h"
+#include "ExhibitionRopeSubsystem.generated.h"
+
+class UCableComponent;
+
+struct FExhibitionRopeSegment
+{
+	AActor* Rope = nullptr;
+	UCableComponent* Cable = nullptr;
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+};
+
+/**
+ * Registry of every rope in the world, fed by the tracked tags. Only actors with a cable are registered.
+ * World space end points are cached and only refreshed when one of the components they depend on moves.
+ */
+UCLASS()
+class MOVEMENTEXHIBITION_API UExhibitionRopeSubsystem : public UExhibitionTaggedActorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintCallable)
+	void RegisterRope(AActor* Rope);
+
+	UFUNCTION(BlueprintCallable)
+	void UnregisterRope(AActor* Rope);
+
+	// Fills OutRopes with the ropes carrying Tag whose segment bounds overlap Bounds. OutRopes is reset first.
+	void QueryRopes(const FName& Tag, const FBox& Bounds, TArray<FExhibitionRopeSegment>& OutRopes) const;
+
+	// Cached segment of a registered rope
+	bool FindRope(const AActor* Rope, FExhibitionRopeSegment& OutRope) const;
+
+	static void GetRopePositions(const UCableComponent* Rope, FVector& StartPosition, FVector& EndPosition);
+
+protected:
+	virtual void RegisterTrackedActor(AActor* Actor) override;
+
+	virtual void UnregisterTrackedActor(AActor* Actor) override;
+
+	void OnRopeTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	void WatchComponent(USceneComponent* Component, const int32 Index);
+
+	void RefreshRope(const int32 Index);
+
+	struct FRopeEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<UCableComponent> Cable;
+		// Components whose transform the end points depend on
+		TArray<TWeakObjectPtr<USceneComponent>, TInlineAllocator<2>> Watched;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		FBox Bounds = FBox(ForceInit);
+	};
+
+	TSparseArray<FRopeEntry> Ropes;
+
+	TMap<TObjectKey<AActor>, int32> RopeIndices;
+
+	// Watched component to the ropes depending on it
+	TMultiMap<TObjectKey<USceneComponent>, int32> WatchedComponents;
+
+	FExhibitionSpatialGrid Grid;
+
+	mutable TArray<int32> QueryScratch;
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid of integer ids, bucketed by the cells their bounds overlap.
+ * Ids are owned by the caller (usually an index into a registry array).
+ */
+struct MOVEMENTEXHIBITION_API FExhibitionSpatialGrid
+{
+	explicit FExhibitionSpatialGrid(const float InCellSize = 2500.f);
+
+	void SetCellSize(const float InCellSize);
+
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+
+	void Add(const int32 Id, const FBox& Bounds);
+
+	void Remove(const int32 Id, const FBox& Bounds);
+
+	// Appends every id whose cells overlap Bounds. Ids spanning several cells are reported once.
+	void Query(const FBox& Bounds, TArray<int32>& OutIds) const;
+
+	void Reset();
+
+	FORCEINLINE bool IsEmpty() const { return Cells.IsEmpty(); }
+
+private:
+	FIntVector ToCell(const FVector& Location) const;
+
+	float CellSize;
+
+	TMap<FIntVector, TArray<int32, TInlineAllocator<4>>> Cells;
+
+	// Ids added with bounds covering more than one cell
+	int32 NumSpanningIds = 0;
+};
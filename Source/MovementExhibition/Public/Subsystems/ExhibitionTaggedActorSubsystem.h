@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExhibitionTaggedActorSubsystem.generated.h"
+
+/**
+ * Base of the registries fed by actor tags.
+ * Actors carrying a tracked tag are handed to RegisterTrackedActor when the tag is tracked, when they spawn or when
+ * their level streams in, and to UnregisterTrackedActor when they leave play or their level streams out.
+ */
+UCLASS(Abstract)
+class MOVEMENTEXHIBITION_API UExhibitionTaggedActorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	// Registers every actor carrying Tag, now and whenever one spawns or streams in
+	void TrackTag(const FName& Tag);
+
+protected:
+	// Called for every actor carrying a tracked tag, possibly more than once
+	virtual void RegisterTrackedActor(AActor* Actor) PURE_VIRTUAL(UExhibitionTaggedActorSubsystem::RegisterTrackedActor, );
+
+	// Called for every actor leaving the world, tracked or not
+	virtual void UnregisterTrackedActor(AActor* Actor) PURE_VIRTUAL(UExhibitionTaggedActorSubsystem::UnregisterTrackedActor, );
+
+	// Unregisters Actor when it leaves play
+	void BindEndPlay(AActor* Actor);
+
+	void UnbindEndPlay(AActor* Actor);
+
+	void RegisterTaggedActors(const FName& Tag);
+
+	bool HasTrackedTag(const AActor* Actor) const;
+
+	void OnActorSpawned(AActor* Actor);
+
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+	UFUNCTION()
+	void OnTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	TSet<FName> TrackedTags;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -10,6 +10,7 @@ public class MovementExhibitionEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V4;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_3;
+		bUseIris = true;
 		ExtraModuleNames.Add("MovementExhibition");
 	}
 }